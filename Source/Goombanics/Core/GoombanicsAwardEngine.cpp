@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsAwardEngine.h"
+#include "Goombanics/Player/GoombanicsPlayerState.h"
+
+void FGoombanicsStatsTable::Reset(int32 ExpectedRows)
+{
+	Values.Reset(ExpectedRows * NumStats);
+	RoleMasks.Reset(ExpectedRows);
+	Players.Reset(ExpectedRows);
+}
+
+void FGoombanicsStatsTable::AddRow(const AGoombanicsPlayerState& PlayerState)
+{
+	const FGoombanicsPlayerScoreData& ScoreData = PlayerState.GetScoreData();
+	for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+	{
+		Values.Add(ScoreData.GetStatValue(static_cast<EGoombanicsStatKey>(StatIndex)));
+	}
+
+	RoleMasks.Add(static_cast<uint8>(FGoombanicsAwardDefinition::MakeRoleMask(PlayerState.GetRole())));
+	Players.Add(&PlayerState);
+}
+
+TArray<FGoombanicsAwardDefinition> FGoombanicsAwardEngine::MakeDefaultDefinitions()
+{
+	auto MakeDefinition = [](FName Id, EGoombanicsAwardType Type, EGoombanicsStatKey Stat, int32 RoleFilter, bool bFallback)
+	{
+		FGoombanicsAwardDefinition Def;
+		Def.AwardId = Id;
+		Def.AwardType = Type;
+		Def.StatKey = Stat;
+		Def.RoleFilter = RoleFilter;
+		Def.bFallbackToAnyRole = bFallback;
+		return Def;
+	};
+
+	const int32 AllRoles = 0x7;
+	const int32 HumanOnly = FGoombanicsAwardDefinition::MakeRoleMask(EGoombanicsRole::Human);
+	const int32 KaijuOnly = FGoombanicsAwardDefinition::MakeRoleMask(EGoombanicsRole::Kaiju);
+
+	TArray<FGoombanicsAwardDefinition> Defs;
+	Defs.Add(MakeDefinition(FName("MostKaijuDamage"), EGoombanicsAwardType::MostKaijuDamage, EGoombanicsStatKey::KaijuDamageDealt, HumanOnly, true));
+	Defs.Add(MakeDefinition(FName("MostCollateralDamage"), EGoombanicsAwardType::MostCollateralDamage, EGoombanicsStatKey::CollateralDamageScore, AllRoles, false));
+	Defs.Add(MakeDefinition(FName("MostDeaths"), EGoombanicsAwardType::MostDeaths, EGoombanicsStatKey::Deaths, AllRoles, false));
+	Defs.Add(MakeDefinition(FName("FinalBlow"), EGoombanicsAwardType::FinalBlow, EGoombanicsStatKey::FinalBlowCount, AllRoles, false));
+	Defs.Add(MakeDefinition(FName("WorstDayEver"), EGoombanicsAwardType::WorstDayEver, EGoombanicsStatKey::CollateralDamageScore, KaijuOnly, true));
+	return Defs;
+}
+
+namespace GoombanicsAwardEngine
+{
+	// Flattened definition so the inner loop touches no UStruct metadata.
+	struct FCompiledAward
+	{
+		int32 StatIndex = 0;
+		float Sign = 1.0f;
+		uint8 RoleMask = 0;
+		bool bFallbackToAnyRole = false;
+		EGoombanicsAwardTieBreak TieBreak = EGoombanicsAwardTieBreak::FirstListed;
+	};
+
+	struct FCandidate
+	{
+		int32 Row = INDEX_NONE;
+		float Key = 0.0f;
+		bool bTied = false;
+	};
+
+	// Returns true if Row should replace Best on an exact tie.
+	static bool WinsTie(EGoombanicsAwardTieBreak TieBreak, const float* Row, const float* BestRow)
+	{
+		static constexpr int32 DeathsIndex = static_cast<int32>(EGoombanicsStatKey::Deaths);
+		static constexpr int32 TotalScoreIndex = static_cast<int32>(EGoombanicsStatKey::TotalScore);
+
+		switch (TieBreak)
+		{
+		case EGoombanicsAwardTieBreak::FewestDeaths:
+			return Row[DeathsIndex] < BestRow[DeathsIndex];
+		case EGoombanicsAwardTieBreak::HighestTotalScore:
+			return Row[TotalScoreIndex] > BestRow[TotalScoreIndex];
+		default:
+			return false;
+		}
+	}
+
+	static void Consider(FCandidate& Best, const FCompiledAward& Award, const FGoombanicsStatsTable& Table, int32 Row, float Key)
+	{
+		if (Best.Row == INDEX_NONE || Key > Best.Key)
+		{
+			Best.Row = Row;
+			Best.Key = Key;
+			Best.bTied = false;
+		}
+		else if (Key == Best.Key)
+		{
+			if (Award.TieBreak == EGoombanicsAwardTieBreak::NoWinner)
+			{
+				Best.bTied = true;
+			}
+			else if (WinsTie(Award.TieBreak, Table.GetRow(Row), Table.GetRow(Best.Row)))
+			{
+				Best.Row = Row;
+			}
+		}
+	}
+}
+
+void FGoombanicsAwardEngine::Evaluate(const TArray<FGoombanicsAwardDefinition>& Definitions, const FGoombanicsStatsTable& Table, TArray<FGoombanicsAwardResult>& OutResults)
+{
+	using namespace GoombanicsAwardEngine;
+
+	const int32 NumAwards = Definitions.Num();
+
+	TArray<FCompiledAward, TInlineAllocator<16>> Compiled;
+	Compiled.SetNum(NumAwards);
+	for (int32 AwardIndex = 0; AwardIndex < NumAwards; ++AwardIndex)
+	{
+		const FGoombanicsAwardDefinition& Def = Definitions[AwardIndex];
+		FCompiledAward& Award = Compiled[AwardIndex];
+		Award.StatIndex = FMath::Clamp(static_cast<int32>(Def.StatKey), 0, FGoombanicsStatsTable::NumStats - 1);
+		Award.Sign = Def.Comparator == EGoombanicsAwardComparator::Lowest ? -1.0f : 1.0f;
+		Award.RoleMask = static_cast<uint8>(Def.RoleFilter);
+		Award.bFallbackToAnyRole = Def.bFallbackToAnyRole;
+		Award.TieBreak = Def.TieBreak;
+	}
+
+	// Eligible and any-role candidates are tracked side by side so role fallback
+	// never needs a second scan.
+	TArray<FCandidate, TInlineAllocator<16>> Eligible;
+	TArray<FCandidate, TInlineAllocator<16>> AnyRole;
+	Eligible.SetNum(NumAwards);
+	AnyRole.SetNum(NumAwards);
+
+	const int32 NumRows = Table.Num();
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		const float* Stats = Table.GetRow(Row);
+		const uint8 RoleMask = Table.GetRoleMask(Row);
+
+		for (int32 AwardIndex = 0; AwardIndex < NumAwards; ++AwardIndex)
+		{
+			const FCompiledAward& Award = Compiled[AwardIndex];
+			const float Key = Stats[Award.StatIndex] * Award.Sign;
+
+			if (Award.RoleMask & RoleMask)
+			{
+				Consider(Eligible[AwardIndex], Award, Table, Row, Key);
+			}
+
+			if (Award.bFallbackToAnyRole)
+			{
+				Consider(AnyRole[AwardIndex], Award, Table, Row, Key);
+			}
+		}
+	}
+
+	OutResults.Reserve(OutResults.Num() + NumAwards);
+	for (int32 AwardIndex = 0; AwardIndex < NumAwards; ++AwardIndex)
+	{
+		const FGoombanicsAwardDefinition& Def = Definitions[AwardIndex];
+		const FCompiledAward& Award = Compiled[AwardIndex];
+
+		const FCandidate& Winner = (Eligible[AwardIndex].Row == INDEX_NONE && Award.bFallbackToAnyRole)
+			? AnyRole[AwardIndex]
+			: Eligible[AwardIndex];
+
+		FGoombanicsAwardResult Result;
+		Result.AwardType = Def.AwardType;
+		Result.AwardId = Def.AwardId;
+
+		if (Winner.Row != INDEX_NONE && !Winner.bTied)
+		{
+			const AGoombanicsPlayerState* WinnerPS = Table.GetPlayer(Winner.Row);
+			Result.WinnerPlayerName = WinnerPS->GetPlayerName();
+			Result.WinnerPlayerId = WinnerPS->GetPlayerId();
+			Result.Value = FMath::Max(0.0f, Table.GetRow(Winner.Row)[Award.StatIndex]);
+		}
+
+		OutResults.Add(Result);
+	}
+}
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GoombanicsTypes.h"
+
+class AGoombanicsPlayerState;
+
+// -----------------------------------------------------------------------------
+// Data-driven end-of-round awards.
+//
+// FGoombanicsStatsTable packs every PlayerState's stats into one row-major float
+// array (one row per player, one column per EGoombanicsStatKey). The engine then
+// evaluates all award definitions in a single linear scan over that table, so
+// dozens of awards for 64 players stay one pass over a few KB of contiguous data.
+// -----------------------------------------------------------------------------
+
+struct GOOMBANICS_API FGoombanicsStatsTable
+{
+	static constexpr int32 NumStats = static_cast<int32>(EGoombanicsStatKey::Count);
+
+	void Reset(int32 ExpectedRows);
+	void AddRow(const AGoombanicsPlayerState& PlayerState);
+
+	int32 Num() const { return Players.Num(); }
+	const float* GetRow(int32 Row) const { return Values.GetData() + Row * NumStats; }
+	uint8 GetRoleMask(int32 Row) const { return RoleMasks[Row]; }
+	const AGoombanicsPlayerState* GetPlayer(int32 Row) const { return Players[Row]; }
+
+private:
+	TArray<float> Values;
+	TArray<uint8> RoleMasks;
+	TArray<const AGoombanicsPlayerState*> Players;
+};
+
+struct GOOMBANICS_API FGoombanicsAwardEngine
+{
+	// Default set matching the original hard-coded awards, with role filtering:
+	// Humans compete for Kaiju damage, a Kaiju player is preferred for Worst Day Ever.
+	static TArray<FGoombanicsAwardDefinition> MakeDefaultDefinitions();
+
+	// Evaluates every definition in one pass. Appends one result per definition, in order.
+	static void Evaluate(const TArray<FGoombanicsAwardDefinition>& Definitions, const FGoombanicsStatsTable& Table, TArray<FGoombanicsAwardResult>& OutResults);
+};
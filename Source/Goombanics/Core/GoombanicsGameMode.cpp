@@ -2,35 +2,52 @@
 
 #include "GoombanicsGameMode.h"
 #include "GoombanicsGameState.h"
+#include "GoombanicsMapPreloadSubsystem.h"
 #include "Goombanics/Player/GoombanicsPlayerState.h"
 #include "Goombanics/Player/GoombanicsCharacter.h"
 #include "Goombanics/Monster/GoombanicsKaijuPawn.h"
+#include "Goombanics/Destruction/GoombanicsDestructionSubsystem.h"
+#include "Goombanics/Net/GoombanicsJoinSnapshotSubsystem.h"
+#include "Goombanics/Data/GoombanicsMapRotationData.h"
 #include "Goombanics/Goombanics.h"
-#include "GameFramework/PlayerStart.h"
-#include "Kismet/GameplayStatics.h"
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/PlayerController.h"
 
+DECLARE_CYCLE_STAT(TEXT("Round Restart"), STAT_GoombanicsRoundRestart, STATGROUP_Goombanics);
+
 // GameMode responsibilities (server-authoritative):
 // - Assign roles at match start / player join.
-// - Own match flow (warmup, in-progress, post-round).
+// - Own match flow (warmup, in-progress, post-round, in-place rematch).
+// - Rotate maps with seamless travel; the next map preloads during post-round.
+//
+// - Choose spawns through the cached spawn registry (scored, reserved, nav-projected).
+// - Respawn dead pawns in place (reset and moved to a fresh start) instead of spawning new ones.
 //
 // TODO(PlayerControlledKaiju): Assign one PlayerState Role=Kaiju and possess the Kaiju pawn.
-// TODO(OnlineScaling): Replace simple respawn transform with nav-query near active combat target.
 
 AGoombanicsGameMode::AGoombanicsGameMode()
 {
 	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	GameStateClass = AGoombanicsGameState::StaticClass();
 	PlayerStateClass = AGoombanicsPlayerState::StaticClass();
 	DefaultPawnClass = AGoombanicsCharacter::StaticClass();
+
+	// Rotation keeps connections and PlayerStates; travel goes through the
+	// TransitionMap set in DefaultEngine.ini.
+	bUseSeamlessTravel = true;
 }
 
 void AGoombanicsGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
 	Super::InitGame(MapName, Options, ErrorMessage);
+
+	if (UGoombanicsSpawnRegistrySubsystem* Registry = GetSpawnRegistry())
+	{
+		Registry->SetScoringSettings(SpawnScoring);
+	}
+
 	UE_LOG(LogGoombanics, Log, TEXT("InitGame: Map=%s"), *MapName);
 }
 
@@ -45,15 +62,28 @@ void AGoombanicsGameMode::StartPlay()
 		GS->SetScoreWeights(ScoreWeights);
 	}
 
+	TickGate.SetReason(this, TickReason_MatchClock, true);
+	TickGate.KeepTickingForBlueprint(this);
+
 	SpawnKaiju();
 
 	UE_LOG(LogGoombanics, Log, TEXT("StartPlay: Warmup phase started"));
+
+	// Boot time and footprint, for comparing the server target with a -nullrhi client.
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	UE_LOG(LogGoombanics, Log, TEXT("StartPlay: %.2f s after launch, %.1f MB resident (peak %.1f MB)%s"),
+		FPlatformTime::Seconds() - GStartTime,
+		MemoryStats.UsedPhysical / (1024.0 * 1024.0),
+		MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0),
+		UE_SERVER ? TEXT(", server build") : TEXT(""));
 }
 
 void AGoombanicsGameMode::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
+	INC_DWORD_STAT(STAT_GoombanicsGameModeTicks);
+
 	AGoombanicsGameState* GS = GetGoombanicsGameState();
 	if (!GS)
 	{
@@ -77,19 +107,22 @@ void AGoombanicsGameMode::Tick(float DeltaSeconds)
 		UpdateMatchTimer(DeltaSeconds);
 		CheckMatchEndConditions();
 	}
-
-	ProcessPendingRespawns(DeltaSeconds);
 }
 
 AActor* AGoombanicsGameMode::ChoosePlayerStart_Implementation(AController* Player)
 {
-	TArray<AActor*> PlayerStarts;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlayerStart::StaticClass(), PlayerStarts);
-
-	if (PlayerStarts.Num() > 0)
+	if (UGoombanicsSpawnRegistrySubsystem* Registry = GetSpawnRegistry())
 	{
-		int32 Index = FMath::RandRange(0, PlayerStarts.Num() - 1);
-		return PlayerStarts[Index];
+		FVector KaijuLocation = FVector::ZeroVector;
+		if (ActiveKaiju)
+		{
+			KaijuLocation = ActiveKaiju->GetActorLocation();
+		}
+
+		if (AActor* Start = Registry->ChoosePlayerStart(ActiveKaiju ? &KaijuLocation : nullptr))
+		{
+			return Start;
+		}
 	}
 
 	return Super::ChoosePlayerStart_Implementation(Player);
@@ -101,7 +134,17 @@ void AGoombanicsGameMode::HandleStartingNewPlayer_Implementation(APlayerControll
 
 	if (AGoombanicsPlayerState* PS = NewPlayer->GetPlayerState<AGoombanicsPlayerState>())
 	{
-		PS->SetRole(EGoombanicsRole::Human);
+		// Players arriving through seamless travel keep the role they had.
+		if (!PS->WasCarriedOver())
+		{
+			PS->SetRole(EGoombanicsRole::Human);
+		}
+
+		// Late joiners get the whole match in one transfer instead of piece by piece.
+		if (UGoombanicsJoinSnapshotSubsystem* Snapshots = UGoombanicsJoinSnapshotSubsystem::Get(this))
+		{
+			Snapshots->SendTo(PS);
+		}
 	}
 }
 
@@ -110,6 +153,22 @@ void AGoombanicsGameMode::RestartPlayer(AController* NewPlayer)
 	Super::RestartPlayer(NewPlayer);
 }
 
+void AGoombanicsGameMode::Logout(AController* Exiting)
+{
+	FGoombanicsTimerHandle RespawnHandle;
+	if (PendingRespawns.RemoveAndCopyValue(Exiting, RespawnHandle))
+	{
+		UGoombanicsTimerWheelSubsystem::CancelTimer(this, RespawnHandle);
+	}
+
+	Super::Logout(Exiting);
+}
+
+APawn* AGoombanicsGameMode::SpawnDefaultPawnFor_Implementation(AController* NewPlayer, AActor* StartSpot)
+{
+	return SpawnDefaultPawnAtTransform(NewPlayer, GetRespawnTransform(NewPlayer, StartSpot));
+}
+
 void AGoombanicsGameMode::StartMatch()
 {
 	if (bMatchStarted)
@@ -137,9 +196,14 @@ void AGoombanicsGameMode::EndMatch(EGoombanicsMatchEndReason Reason)
 			return;
 		}
 
+		// Breaks from this frame count toward final scores.
+		GS->FlushPendingDestruction();
+
 		GS->SetMatchPhase(EGoombanicsMatchPhase::PostRound);
 		GS->OnMatchEnded.Broadcast(Reason);
 
+		TickGate.SetReason(this, TickReason_MatchClock, false);
+
 		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
 		{
 			if (APlayerController* PC = It->Get())
@@ -147,14 +211,141 @@ void AGoombanicsGameMode::EndMatch(EGoombanicsMatchEndReason Reason)
 				if (AGoombanicsPlayerState* PS = PC->GetPlayerState<AGoombanicsPlayerState>())
 				{
 					PS->CalculateFinalScore();
+					PS->AccumulateLifetimeStats();
 				}
 			}
 		}
+
+		PrepareNextMap();
 	}
 
 	UE_LOG(LogGoombanics, Log, TEXT("Match ended: %d"), static_cast<int32>(Reason));
 }
 
+void AGoombanicsGameMode::PrepareNextMap()
+{
+	const FGoombanicsMapRotationEntry* Next = MapRotation ? MapRotation->FindNextEntry(GetWorld()->GetOutermost()->GetName()) : nullptr;
+	AGoombanicsGameState* GS = GetGoombanicsGameState();
+	if (!Next || !GS)
+	{
+		return;
+	}
+
+	// Replicates to clients; every machine preloads it while the awards are up.
+	GS->SetNextMap(*Next);
+
+	if (PostRoundTravelDelay > 0.0f)
+	{
+		UGoombanicsTimerWheelSubsystem::CancelTimer(this, TravelTimerHandle);
+		TravelTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, PostRoundTravelDelay, FSimpleDelegate::CreateUObject(this, &AGoombanicsGameMode::TravelToNextMap));
+	}
+
+	UE_LOG(LogGoombanics, Log, TEXT("Next map: %s"), *Next->Map.GetLongPackageName());
+}
+
+void AGoombanicsGameMode::TravelToNextMap()
+{
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, TravelTimerHandle);
+
+	const AGoombanicsGameState* GS = GetGoombanicsGameState();
+	const FString NextMap = GS ? GS->GetNextMap().Map.GetLongPackageName() : FString();
+	if (NextMap.IsEmpty())
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("TravelToNextMap: no next map (MapRotation unset or empty)"));
+		return;
+	}
+
+	const UGoombanicsMapPreloadSubsystem* Preload = UGoombanicsMapPreloadSubsystem::Get(this);
+	UE_LOG(LogGoombanics, Log, TEXT("TravelToNextMap: %s (%s, preload %s)"), *NextMap,
+		bUseSeamlessTravel ? TEXT("seamless") : TEXT("hard"),
+		Preload && Preload->IsPreloadComplete() ? TEXT("complete") : TEXT("incomplete"));
+
+	GetWorld()->ServerTravel(NextMap);
+}
+
+void AGoombanicsGameMode::RestartRound()
+{
+	AGoombanicsGameState* GS = GetGoombanicsGameState();
+	if (!GS || GS->GetMatchPhase() != EGoombanicsMatchPhase::PostRound)
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("RestartRound: only valid in PostRound"));
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GoombanicsRoundRestart);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Respawns scheduled last round would land in the middle of warmup; a
+	// rematch replaces the pending map travel.
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, TravelTimerHandle);
+	for (TPair<TObjectPtr<AController>, FGoombanicsTimerHandle>& Pending : PendingRespawns)
+	{
+		UGoombanicsTimerWheelSubsystem::CancelTimer(this, Pending.Value);
+	}
+	PendingRespawns.Reset();
+
+	int32 NumRestored = 0;
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		NumRestored = Destruction->ResetRound();
+	}
+
+	GS->ResetRoundState();
+
+	if (ActiveKaiju)
+	{
+		ActiveKaiju->ResetMonster(ChooseKaijuSpawnTransform());
+	}
+	else
+	{
+		SpawnKaiju();
+	}
+
+	int32 NumPlayers = 0;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (APlayerController* PC = It->Get())
+		{
+			ResetPlayerForRound(PC);
+			++NumPlayers;
+		}
+	}
+
+	bMatchStarted = false;
+	CurrentWarmupTime = 0.0f;
+	GS->SetMatchPhase(EGoombanicsMatchPhase::Warmup);
+	GS->SetTimeRemaining(WarmupDuration);
+	TickGate.SetReason(this, TickReason_MatchClock, true);
+
+	UE_LOG(LogGoombanics, Log, TEXT("RestartRound: %d breakables restored, %d players reset in %.2f ms"),
+		NumRestored, NumPlayers, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void AGoombanicsGameMode::ResetPlayerForRound(APlayerController* PC)
+{
+	AGoombanicsPlayerState* PS = PC->GetPlayerState<AGoombanicsPlayerState>();
+	if (PS)
+	{
+		PS->ResetScore();
+	}
+
+	// A Kaiju player's pawn is the Kaiju, already reset.
+	if (PS && PS->GetRole() == EGoombanicsRole::Kaiju)
+	{
+		return;
+	}
+
+	AGoombanicsCharacter* Character = Cast<AGoombanicsCharacter>(PC->GetPawn());
+	if (!Character)
+	{
+		RestartPlayer(PC);
+		return;
+	}
+
+	// Living or dead, the pawn is kept and moved to a fresh, reserved start.
+	RespawnPawnInPlace(PC, Character);
+}
+
 void AGoombanicsGameMode::CreateLocalPlayers(int32 NumPlayers)
 {
 	NumPlayers = FMath::Clamp(NumPlayers, 1, 4);
@@ -200,7 +391,16 @@ void AGoombanicsGameMode::RequestPlayerRespawn(AController* Controller)
 
 	if (!PendingRespawns.Contains(Controller))
 	{
-		PendingRespawns.Add(Controller, RespawnDelay);
+		PendingRespawns.Add(Controller, UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, RespawnDelay, FSimpleDelegate::CreateUObject(
+			this, &AGoombanicsGameMode::OnRespawnTimerElapsed, TWeakObjectPtr<AController>(Controller))));
+
+		if (APawn* DeadPawn = Controller->GetPawn())
+		{
+			if (UGoombanicsSpawnRegistrySubsystem* Registry = GetSpawnRegistry())
+			{
+				Registry->RecordDeath(DeadPawn->GetActorLocation());
+			}
+		}
 
 		if (AGoombanicsPlayerState* PS = Controller->GetPlayerState<AGoombanicsPlayerState>())
 		{
@@ -213,27 +413,21 @@ void AGoombanicsGameMode::RequestPlayerRespawn(AController* Controller)
 
 void AGoombanicsGameMode::SpawnKaiju()
 {
-	if (!KaijuPawnClass)
+	const TSubclassOf<AGoombanicsKaijuPawn> PawnClass = GetKaijuPawnClassForMap();
+	if (!PawnClass)
 	{
 		UE_LOG(LogGoombanics, Warning, TEXT("SpawnKaiju: No KaijuPawnClass set"));
 		return;
 	}
 
-	FVector SpawnLocation = FVector(0.0f, 0.0f, 500.0f);
-	FRotator SpawnRotation = FRotator::ZeroRotator;
-
-	TArray<AActor*> KaijuSpawns;
-	UGameplayStatics::GetAllActorsWithTag(GetWorld(), FName("KaijuSpawn"), KaijuSpawns);
-	if (KaijuSpawns.Num() > 0)
-	{
-		SpawnLocation = KaijuSpawns[0]->GetActorLocation();
-		SpawnRotation = KaijuSpawns[0]->GetActorRotation();
-	}
+	const FTransform SpawnTransform = ChooseKaijuSpawnTransform();
+	const FVector SpawnLocation = SpawnTransform.GetLocation();
+	const FRotator SpawnRotation = SpawnTransform.Rotator();
 
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-	ActiveKaiju = GetWorld()->SpawnActor<AGoombanicsKaijuPawn>(KaijuPawnClass, SpawnLocation, SpawnRotation, SpawnParams);
+	ActiveKaiju = GetWorld()->SpawnActor<AGoombanicsKaijuPawn>(PawnClass, SpawnLocation, SpawnRotation, SpawnParams);
 
 	if (ActiveKaiju)
 	{
@@ -241,6 +435,33 @@ void AGoombanicsGameMode::SpawnKaiju()
 	}
 }
 
+FTransform AGoombanicsGameMode::ChooseKaijuSpawnTransform()
+{
+	if (UGoombanicsSpawnRegistrySubsystem* Registry = GetSpawnRegistry())
+	{
+		if (AActor* KaijuSpawn = Registry->ChooseKaijuSpawn())
+		{
+			const TSubclassOf<AGoombanicsKaijuPawn> PawnClass = GetKaijuPawnClassForMap();
+			const float HalfHeight = PawnClass ? PawnClass->GetDefaultObject<APawn>()->GetDefaultHalfHeight() : 0.0f;
+			return Registry->GetSpawnTransform(KaijuSpawn, HalfHeight);
+		}
+	}
+
+	return FTransform(FVector(0.0f, 0.0f, 500.0f));
+}
+
+TSubclassOf<AGoombanicsKaijuPawn> AGoombanicsGameMode::GetKaijuPawnClassForMap() const
+{
+	const FGoombanicsMapRotationEntry* Entry = MapRotation ? MapRotation->FindEntry(GetWorld()->GetOutermost()->GetName()) : nullptr;
+	if (Entry && !Entry->KaijuPawnClass.IsNull())
+	{
+		// Resident after a rotation (preloaded); only the first map of a session loads it here.
+		return Entry->KaijuPawnClass.LoadSynchronous();
+	}
+
+	return KaijuPawnClass;
+}
+
 void AGoombanicsGameMode::SetPlayerRole(APlayerState* PlayerState, EGoombanicsRole NewRole)
 {
 	if (AGoombanicsPlayerState* PS = Cast<AGoombanicsPlayerState>(PlayerState))
@@ -285,6 +506,15 @@ void AGoombanicsGameMode::CheckMatchEndConditions()
 		return;
 	}
 
+	if (const UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		if (Destruction->FindLostProtectedDistrict() != INDEX_NONE)
+		{
+			EndMatch(EGoombanicsMatchEndReason::ProtectedDistrictDestroyed);
+			return;
+		}
+	}
+
 	if (GS->GetTimeRemaining() <= 0.0f)
 	{
 		EndMatch(EGoombanicsMatchEndReason::TimerExpired);
@@ -301,32 +531,57 @@ void AGoombanicsGameMode::UpdateMatchTimer(float DeltaSeconds)
 	}
 }
 
-void AGoombanicsGameMode::ProcessPendingRespawns(float DeltaSeconds)
+void AGoombanicsGameMode::OnRespawnTimerElapsed(TWeakObjectPtr<AController> Controller)
 {
-	TArray<AController*> ToRespawn;
-
-	for (auto& Pair : PendingRespawns)
+	AController* ControllerPtr = Controller.Get();
+	if (!ControllerPtr)
 	{
-		Pair.Value -= DeltaSeconds;
-		if (Pair.Value <= 0.0f)
-		{
-			ToRespawn.Add(Pair.Key);
-		}
+		return;
 	}
 
-	for (AController* Controller : ToRespawn)
+	PendingRespawns.Remove(ControllerPtr);
+
+	// The dead pawn is still possessed: reset it where it is rather than destroy and respawn.
+	if (AGoombanicsCharacter* DeadPawn = Cast<AGoombanicsCharacter>(ControllerPtr->GetPawn()))
 	{
-		PendingRespawns.Remove(Controller);
-		RestartPlayer(Controller);
+		RespawnPawnInPlace(ControllerPtr, DeadPawn);
+		return;
 	}
+
+	RestartPlayer(ControllerPtr);
 }
 
-FTransform AGoombanicsGameMode::GetRespawnTransform(AController* Controller) const
+void AGoombanicsGameMode::RespawnPawnInPlace(AController* Controller, AGoombanicsCharacter* Character)
 {
-	AActor* PlayerStart = ChoosePlayerStart(Controller);
-	if (PlayerStart)
+	AActor* StartSpot = ChoosePlayerStart(Controller);
+	const FTransform SpawnTransform = StartSpot ? GetRespawnTransform(Controller, StartSpot) : Character->GetActorTransform();
+	Character->ResetForRespawn(SpawnTransform);
+	Controller->ClientSetRotation(SpawnTransform.Rotator(), true);
+}
+
+FTransform AGoombanicsGameMode::GetRespawnTransform(AController* Controller, AActor* StartSpot) const
+{
+	if (!StartSpot)
+	{
+		return FTransform::Identity;
+	}
+
+	float HalfHeight = 0.0f;
+	if (UClass* PawnClass = GetDefaultPawnClassForController(Controller))
+	{
+		HalfHeight = PawnClass->GetDefaultObject<APawn>()->GetDefaultHalfHeight();
+	}
+
+	if (UGoombanicsSpawnRegistrySubsystem* Registry = GetSpawnRegistry())
 	{
-		return PlayerStart->GetActorTransform();
+		return Registry->GetSpawnTransform(StartSpot, HalfHeight);
 	}
-	return FTransform::Identity;
+
+	return StartSpot->GetActorTransform();
+}
+
+UGoombanicsSpawnRegistrySubsystem* AGoombanicsGameMode::GetSpawnRegistry() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UGoombanicsSpawnRegistrySubsystem>() : nullptr;
 }
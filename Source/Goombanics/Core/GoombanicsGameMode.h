@@ -5,11 +5,16 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 #include "GoombanicsTypes.h"
+#include "GoombanicsSpawnRegistrySubsystem.h"
+#include "GoombanicsTimerWheelSubsystem.h"
+#include "GoombanicsTickGate.h"
 #include "GoombanicsGameMode.generated.h"
 
 class AGoombanicsGameState;
 class AGoombanicsPlayerState;
 class AGoombanicsKaijuPawn;
+class AGoombanicsCharacter;
+class UGoombanicsMapRotationDataAsset;
 
 UCLASS()
 class GOOMBANICS_API AGoombanicsGameMode : public AGameModeBase
@@ -25,6 +30,8 @@ public:
 	virtual AActor* ChoosePlayerStart_Implementation(AController* Player) override;
 	virtual void HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer) override;
 	virtual void RestartPlayer(AController* NewPlayer) override;
+	virtual void Logout(AController* Exiting) override;
+	virtual APawn* SpawnDefaultPawnFor_Implementation(AController* NewPlayer, AActor* StartSpot) override;
 
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Match")
 	void StartMatch();
@@ -32,6 +39,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Match")
 	void EndMatch(EGoombanicsMatchEndReason Reason);
 
+	// Rematch on the loaded level, from PostRound back to Warmup: breakables are
+	// restored from the destruction bitset, the Kaiju and scores reset, pawns moved
+	// to fresh spawns. No level reload, no respawned actors.
+	UFUNCTION(BlueprintCallable, Category = "Goombanics|Match")
+	void RestartRound();
+
+	// Seamless travel to the GameState's NextMap (through the transition map).
+	// PlayerStates carry over; the next map was preloaded during PostRound.
+	UFUNCTION(BlueprintCallable, Category = "Goombanics|Match")
+	void TravelToNextMap();
+
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|LocalPlayers")
 	void CreateLocalPlayers(int32 NumPlayers);
 
@@ -72,20 +90,47 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Config")
 	TSubclassOf<AGoombanicsKaijuPawn> KaijuPawnClass;
 
+	// Maps played in order. Unset: rounds only restart in place (RestartRound).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Config")
+	TObjectPtr<UGoombanicsMapRotationDataAsset> MapRotation;
+
+	// End-of-round screen time before TravelToNextMap. <= 0 leaves travel to Blueprint.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Config")
+	float PostRoundTravelDelay = 15.0f;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Config")
 	FGoombanicsScoreWeights ScoreWeights;
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Config")
+	FGoombanicsSpawnScoringSettings SpawnScoring;
+
 protected:
 	virtual void CheckMatchEndConditions();
 	virtual void UpdateMatchTimer(float DeltaSeconds);
-	virtual void ProcessPendingRespawns(float DeltaSeconds);
-	virtual FTransform GetRespawnTransform(AController* Controller) const;
+	virtual void OnRespawnTimerElapsed(TWeakObjectPtr<AController> Controller);
+	virtual FTransform GetRespawnTransform(AController* Controller, AActor* StartSpot) const;
+	FTransform ChooseKaijuSpawnTransform();
+	TSubclassOf<AGoombanicsKaijuPawn> GetKaijuPawnClassForMap() const;
+	void PrepareNextMap();
+	void ResetPlayerForRound(APlayerController* PC);
+	UGoombanicsSpawnRegistrySubsystem* GetSpawnRegistry() const;
+	// Resets a (usually dead) character and moves it to a fresh, reserved start; no spawn or destroy.
+	void RespawnPawnInPlace(AController* Controller, AGoombanicsCharacter* Character);
 
 	UPROPERTY()
 	TObjectPtr<AGoombanicsKaijuPawn> ActiveKaiju;
 
 	UPROPERTY()
-	TMap<AController*, float> PendingRespawns;
+	TMap<TObjectPtr<AController>, FGoombanicsTimerHandle> PendingRespawns;
+
+	FGoombanicsTimerHandle TravelTimerHandle;
+
+	// Ticks only while a warmup or match clock is running; asleep in PostRound.
+	enum ETickReason : uint32
+	{
+		TickReason_MatchClock = 1 << 0,
+	};
+	FGoombanicsTickGate TickGate;
 
 	float CurrentWarmupTime = 0.0f;
 	bool bMatchStarted = false;
@@ -1,8 +1,11 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GoombanicsGameState.h"
+#include "GoombanicsAwardEngine.h"
+#include "GoombanicsMapPreloadSubsystem.h"
 #include "Goombanics/Player/GoombanicsPlayerState.h"
 #include "Net/UnrealNetwork.h"
+#include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "Templates/NumericLimits.h"
 
@@ -11,6 +14,8 @@ AGoombanicsGameState::AGoombanicsGameState()
 	WeakPointStates.Add(FGoombanicsWeakPointState{EGoombanicsWeakPointType::LeftLeg, 100.0f, 100.0f, false});
 	WeakPointStates.Add(FGoombanicsWeakPointState{EGoombanicsWeakPointType::RightLeg, 100.0f, 100.0f, false});
 	WeakPointStates.Add(FGoombanicsWeakPointState{EGoombanicsWeakPointType::Head, 200.0f, 200.0f, false});
+
+	AwardDefinitions = FGoombanicsAwardEngine::MakeDefaultDefinitions();
 }
 
 void AGoombanicsGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -29,6 +34,25 @@ void AGoombanicsGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 	DOREPLIFETIME(AGoombanicsGameState, ScoreWeights);
 	DOREPLIFETIME(AGoombanicsGameState, MatchEndReason);
 	DOREPLIFETIME(AGoombanicsGameState, EndOfRoundAwards);
+	DOREPLIFETIME(AGoombanicsGameState, NextMap);
+}
+
+void AGoombanicsGameState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (HasAuthority())
+	{
+		PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &AGoombanicsGameState::OnWorldPostActorTick);
+	}
+}
+
+void AGoombanicsGameState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AGoombanicsGameState::SetMatchPhase(EGoombanicsMatchPhase NewPhase)
@@ -57,16 +81,120 @@ void AGoombanicsGameState::SetDestructionPercent(float NewPercent)
 
 void AGoombanicsGameState::AddDestructionValue(float Value, APlayerState* Instigator)
 {
-	CurrentDestructionValue += Value;
-	float NewPercent = (TotalDestructionValue > 0.0f) 
-		? (CurrentDestructionValue / TotalDestructionValue) * 100.0f 
+	PendingMeterValue += Value;
+	bHasPendingDestruction = true;
+
+	if (!Instigator)
+	{
+		return;
+	}
+
+	// A handful of players: a linear scan beats hashing.
+	FCollateralAccumulator* Accumulator = CollateralAccumulators.FindByPredicate([Instigator](const FCollateralAccumulator& Entry)
+	{
+		return Entry.Instigator == Instigator;
+	});
+	if (!Accumulator)
+	{
+		Accumulator = &CollateralAccumulators.AddDefaulted_GetRef();
+		Accumulator->Instigator = Instigator;
+	}
+
+	Accumulator->PendingValue += Value;
+	++Accumulator->PendingBreaks;
+}
+
+void AGoombanicsGameState::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld() && bHasPendingDestruction)
+	{
+		FlushPendingDestruction();
+	}
+}
+
+void AGoombanicsGameState::FlushPendingDestruction()
+{
+	if (!bHasPendingDestruction)
+	{
+		return;
+	}
+
+	bHasPendingDestruction = false;
+
+	const double Now = GetServerWorldTimeSeconds();
+	const FGoombanicsScoreMultipliers& Multipliers = GetScoreMultipliers();
+
+	for (int32 Index = CollateralAccumulators.Num() - 1; Index >= 0; --Index)
+	{
+		FCollateralAccumulator& Accumulator = CollateralAccumulators[Index];
+		AGoombanicsPlayerState* PS = Cast<AGoombanicsPlayerState>(Accumulator.Instigator.Get());
+		if (!PS)
+		{
+			CollateralAccumulators.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (Accumulator.PendingBreaks == 0)
+		{
+			continue;
+		}
+
+		// Chain: this frame's breaks continue it if the last ones were within the window.
+		const bool bChainContinues = Accumulator.ChainBreaks > 0 && (Now - Accumulator.LastBreakTime) <= Multipliers.CollateralChainWindow;
+		Accumulator.ChainBreaks = (bChainContinues ? Accumulator.ChainBreaks : 0) + Accumulator.PendingBreaks;
+		Accumulator.LastBreakTime = Now;
+
+		const float Multiplier = Accumulator.ChainBreaks >= Multipliers.CollateralChainMinBreaks ? Multipliers.CollateralChainMultiplier : 1.0f;
+		PS->AddCollateralDamage(Accumulator.PendingValue * Multiplier);
+
+		Accumulator.PendingValue = 0.0f;
+		Accumulator.PendingBreaks = 0;
+	}
+
+	// The meter tracks what was actually destroyed; chains only affect player score.
+	CurrentDestructionValue += PendingMeterValue;
+	PendingMeterValue = 0.0f;
+
+	const float NewPercent = (TotalDestructionValue > 0.0f)
+		? (CurrentDestructionValue / TotalDestructionValue) * 100.0f
 		: 0.0f;
 	SetDestructionPercent(NewPercent);
+}
 
-	if (AGoombanicsPlayerState* PS = Cast<AGoombanicsPlayerState>(Instigator))
+int32 AGoombanicsGameState::GetCollateralChainLength(APlayerState* PlayerState) const
+{
+	const FCollateralAccumulator* Accumulator = CollateralAccumulators.FindByPredicate([PlayerState](const FCollateralAccumulator& Entry)
 	{
-		PS->AddCollateralDamage(Value);
+		return Entry.Instigator == PlayerState;
+	});
+
+	if (!Accumulator || GetServerWorldTimeSeconds() - Accumulator->LastBreakTime > GetScoreMultipliers().CollateralChainWindow)
+	{
+		return 0;
 	}
+	return Accumulator->ChainBreaks;
+}
+
+const FGoombanicsScoreMultipliers& AGoombanicsGameState::GetScoreMultipliers() const
+{
+	static const FGoombanicsScoreMultipliers Defaults;
+	return ScoreMultipliers ? ScoreMultipliers->Multipliers : Defaults;
+}
+
+void AGoombanicsGameState::ResetRoundState()
+{
+	CollateralAccumulators.Reset();
+	PendingMeterValue = 0.0f;
+	bHasPendingDestruction = false;
+
+	CurrentDestructionValue = 0.0f;
+	SetDestructionPercent(0.0f);
+	SetTotalledAchieved(false);
+	SetKaijuStaggered(false);
+
+	// Not SetMatchEndReason: that announces a match end.
+	MatchEndReason = EGoombanicsMatchEndReason::None;
+	EndOfRoundAwards = FGoombanicsEndOfRoundAwards();
 }
 
 void AGoombanicsGameState::SetKaijuHealthPercent(float NewPercent)
@@ -235,97 +363,31 @@ TArray<FGoombanicsScoreboardEntry> AGoombanicsGameState::GetSortedScoreboard(int
 
 void AGoombanicsGameState::ComputeEndOfRoundAwards()
 {
-	TArray<AGoombanicsPlayerState*> GoombanicsStates;
-	GoombanicsStates.Reserve(PlayerArray.Num());
+	FGoombanicsStatsTable StatsTable;
+	StatsTable.Reset(PlayerArray.Num());
 	for (APlayerState* PS : PlayerArray)
 	{
-		if (AGoombanicsPlayerState* GPS = Cast<AGoombanicsPlayerState>(PS))
+		if (const AGoombanicsPlayerState* GPS = Cast<AGoombanicsPlayerState>(PS))
 		{
-			GoombanicsStates.Add(GPS);
-		}
-	}
-
-	// TODO(PlayerControlledKaiju): When a player is the Kaiju, consider role-based filtering for awards:
-	// - Humans compete for "Most Kaiju Damage" etc.
-	// - Kaiju player competes for collateral-focused awards.
-
-	auto MakeAward = [](EGoombanicsAwardType Type, const AGoombanicsPlayerState* Winner, float Value)
-	{
-		FGoombanicsAwardResult R;
-		R.AwardType = Type;
-		R.WinnerPlayerName = Winner ? Winner->GetPlayerName() : FString();
-		R.WinnerPlayerId = Winner ? Winner->GetPlayerId() : -1;
-		R.Value = Value;
-		return R;
-	};
-
-	const AGoombanicsPlayerState* MostKaijuDamagePS = nullptr;
-	const AGoombanicsPlayerState* MostCollateralDamagePS = nullptr;
-	const AGoombanicsPlayerState* MostDeathsPS = nullptr;
-	const AGoombanicsPlayerState* MostFinalBlowsPS = nullptr;
-	const AGoombanicsPlayerState* WorstDayEverPS = nullptr;
-
-	float MostKaijuDamage = -1.0f;
-	float MostCollateralDamage = -1.0f;
-	int32 MostDeaths = -1;
-	int32 MostFinalBlows = -1;
-	float WorstDayEverValue = -1.0f;
-
-	for (const AGoombanicsPlayerState* PS : GoombanicsStates)
-	{
-		if (!PS)
-		{
-			continue;
-		}
-
-		if (PS->GetKaijuDamageDealt() > MostKaijuDamage)
-		{
-			MostKaijuDamage = PS->GetKaijuDamageDealt();
-			MostKaijuDamagePS = PS;
-		}
-
-		if (PS->GetCollateralDamageScore() > MostCollateralDamage)
-		{
-			MostCollateralDamage = PS->GetCollateralDamageScore();
-			MostCollateralDamagePS = PS;
-		}
-
-		if (PS->GetDeaths() > MostDeaths)
-		{
-			MostDeaths = PS->GetDeaths();
-			MostDeathsPS = PS;
-		}
-
-		if (PS->GetFinalBlowCount() > MostFinalBlows)
-		{
-			MostFinalBlows = PS->GetFinalBlowCount();
-			MostFinalBlowsPS = PS;
-		}
-
-		// WorstDayEver placeholder: award to the Kaiju player if present; otherwise highest collateral.
-		const bool bIsKaijuRole = PS->GetRole() == EGoombanicsRole::Kaiju;
-		const float CandidateCollateral = PS->GetCollateralDamageScore();
-		if ((bIsKaijuRole && CandidateCollateral >= 0.0f) || (!WorstDayEverPS && CandidateCollateral >= 0.0f))
-		{
-			if (CandidateCollateral > WorstDayEverValue)
-			{
-				WorstDayEverValue = CandidateCollateral;
-				WorstDayEverPS = PS;
-			}
+			StatsTable.AddRow(*GPS);
 		}
 	}
 
+	// Role filtering lives in the definitions (see FGoombanicsAwardEngine::MakeDefaultDefinitions):
+	// Humans compete for Kaiju damage, a Kaiju player is preferred for collateral-focused awards.
 	FGoombanicsEndOfRoundAwards NewAwards;
-	NewAwards.Awards.Add(MakeAward(EGoombanicsAwardType::MostKaijuDamage, MostKaijuDamagePS, FMath::Max(0.0f, MostKaijuDamage)));
-	NewAwards.Awards.Add(MakeAward(EGoombanicsAwardType::MostCollateralDamage, MostCollateralDamagePS, FMath::Max(0.0f, MostCollateralDamage)));
-	NewAwards.Awards.Add(MakeAward(EGoombanicsAwardType::MostDeaths, MostDeathsPS, (float)FMath::Max(0, MostDeaths)));
-	NewAwards.Awards.Add(MakeAward(EGoombanicsAwardType::FinalBlow, MostFinalBlowsPS, (float)FMath::Max(0, MostFinalBlows)));
-	NewAwards.Awards.Add(MakeAward(EGoombanicsAwardType::WorstDayEver, WorstDayEverPS, FMath::Max(0.0f, WorstDayEverValue)));
+	FGoombanicsAwardEngine::Evaluate(AwardDefinitions, StatsTable, NewAwards.Awards);
 
 	EndOfRoundAwards = NewAwards;
 	OnRep_EndOfRoundAwards();
 }
 
+void AGoombanicsGameState::SetNextMap(const FGoombanicsMapRotationEntry& Entry)
+{
+	NextMap = Entry;
+	OnRep_NextMap();
+}
+
 void AGoombanicsGameState::SetTotalDestructionValue(float Value)
 {
 	TotalDestructionValue = FMath::Max(1.0f, Value);
@@ -355,3 +417,14 @@ void AGoombanicsGameState::OnRep_EndOfRoundAwards()
 {
 	// UI can poll GetEndOfRoundAwards() or bind to MatchEnded delegate.
 }
+
+void AGoombanicsGameState::OnRep_NextMap()
+{
+	if (NextMap.IsValid())
+	{
+		if (UGoombanicsMapPreloadSubsystem* Preload = UGoombanicsMapPreloadSubsystem::Get(this))
+		{
+			Preload->Preload(NextMap);
+		}
+	}
+}
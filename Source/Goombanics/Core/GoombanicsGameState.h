@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameStateBase.h"
 #include "GoombanicsTypes.h"
+#include "Goombanics/Data/GoombanicsGameplayTuningData.h"
+#include "Goombanics/Data/GoombanicsMapRotationData.h"
 #include "GoombanicsGameState.generated.h"
 
 UCLASS()
@@ -16,6 +18,8 @@ public:
 	AGoombanicsGameState();
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// -----------------------------------------------------------------------------
 	// UI Data Access (WRITE-ONLY scaffolding)
@@ -42,9 +46,30 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Destruction")
 	void SetDestructionPercent(float NewPercent);
 
+	// Server: queue one break's value. Contributions are summed per instigator and
+	// applied once at the end of the frame (see FlushPendingDestruction).
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Destruction")
 	void AddDestructionValue(float Value, APlayerState* Instigator);
 
+	// Server: apply queued destruction now (meter, collateral, chains, one broadcast).
+	// Runs automatically after actors tick; call directly when the result is needed this frame.
+	UFUNCTION(BlueprintCallable, Category = "Goombanics|Destruction")
+	void FlushPendingDestruction();
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Scoring")
+	int32 GetCollateralChainLength(APlayerState* PlayerState) const;
+
+	// Server: round reset. Clears the meter, pending destruction, collateral chains,
+	// end reason and awards. Kaiju health and weak points are pushed by the Kaiju.
+	void ResetRoundState();
+
+	// Map the server will travel to after this round; invalid if there is no rotation.
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Rotation")
+	const FGoombanicsMapRotationEntry& GetNextMap() const { return NextMap; }
+
+	// Server: announce the next map. Every machine starts preloading it (see UGoombanicsMapPreloadSubsystem).
+	void SetNextMap(const FGoombanicsMapRotationEntry& Entry);
+
 	UFUNCTION(BlueprintPure, Category = "Goombanics|Kaiju")
 	float GetKaijuHealthPercent() const { return KaijuHealthPercent; }
 
@@ -87,7 +112,7 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Goombanics|UI")
 	const FGoombanicsEndOfRoundAwards& GetEndOfRoundAwards() const { return EndOfRoundAwards; }
 
-	// Computes award results from current PlayerStates.
+	// Computes award results from current PlayerStates in one pass over AwardDefinitions.
 	// Intended to be called by GameMode when transitioning to PostRound.
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|UI")
 	void ComputeEndOfRoundAwards();
@@ -111,6 +136,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Destruction")
 	void SetTotalDestructionValue(float Value);
 
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
+	float GetCurrentDestructionValue() const { return CurrentDestructionValue; }
+
+	// Award rules as data. Defaults reproduce the original five awards; designers can
+	// add entries without code as long as the stat exists in EGoombanicsStatKey.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Goombanics|Awards")
+	TArray<FGoombanicsAwardDefinition> AwardDefinitions;
+
+	// Score tuning, including the collateral chain. Unset uses the struct defaults.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Goombanics|Scoring")
+	TObjectPtr<UGoombanicsScoreMultipliersDataAsset> ScoreMultipliers;
+
+	const FGoombanicsScoreMultipliers& GetScoreMultipliers() const;
+
 	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Events")
 	FOnMatchPhaseChanged OnMatchPhaseChanged;
 
@@ -169,6 +208,34 @@ protected:
 	UPROPERTY(ReplicatedUsing = OnRep_EndOfRoundAwards, BlueprintReadOnly, Category = "Goombanics|UI")
 	FGoombanicsEndOfRoundAwards EndOfRoundAwards;
 
+	// Set at round end; soft paths only, sent once per round.
+	UPROPERTY(ReplicatedUsing = OnRep_NextMap, BlueprintReadOnly, Category = "Goombanics|Rotation")
+	FGoombanicsMapRotationEntry NextMap;
+
+	// -----------------------------------------------------------------------------
+	// Batched destruction (server only)
+	//
+	// One stomp can break hundreds of props in a frame. Each break only adds to
+	// PendingMeterValue and its instigator's entry; the post-actor-tick flush then
+	// updates CurrentDestructionValue, each player's collateral and the percent once.
+	// Entries persist between frames to track collateral chains.
+	// -----------------------------------------------------------------------------
+	struct FCollateralAccumulator
+	{
+		TWeakObjectPtr<APlayerState> Instigator;
+		float PendingValue = 0.0f;
+		int32 PendingBreaks = 0;
+		int32 ChainBreaks = 0;
+		double LastBreakTime = 0.0;
+	};
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	TArray<FCollateralAccumulator> CollateralAccumulators;
+	float PendingMeterValue = 0.0f;
+	bool bHasPendingDestruction = false;
+	FDelegateHandle PostActorTickHandle;
+
 	UFUNCTION()
 	void OnRep_MatchPhase();
 
@@ -183,4 +250,7 @@ protected:
 
 	UFUNCTION()
 	void OnRep_EndOfRoundAwards();
+
+	UFUNCTION()
+	void OnRep_NextMap();
 };
@@ -0,0 +1,183 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsMapPreloadSubsystem.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+static TAutoConsoleVariable<int32> CVarRotationPreload(
+	TEXT("goombanics.Rotation.Preload"),
+	1,
+	TEXT("Preload the next rotation map, its Kaiju, weapons and breakable manifest during the end-of-round screen.\n")
+	TEXT("0 leaves all loading to the travel itself."),
+	ECVF_Default);
+
+UGoombanicsMapPreloadSubsystem* UGoombanicsMapPreloadSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UGoombanicsMapPreloadSubsystem>() : nullptr;
+}
+
+void UGoombanicsMapPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UGoombanicsMapPreloadSubsystem::OnPostLoadMap);
+}
+
+void UGoombanicsMapPreloadSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	ReleasePreload();
+
+	Super::Deinitialize();
+}
+
+void UGoombanicsMapPreloadSubsystem::Preload(const FGoombanicsMapRotationEntry& Entry)
+{
+	const FString MapPackageName = Entry.Map.GetLongPackageName();
+	if (MapPackageName.IsEmpty() || MapPackageName == PreloadedMapName || !CVarRotationPreload.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	ReleasePreload();
+
+	PreloadedMapName = MapPackageName;
+	PreloadStartTime = FPlatformTime::Seconds();
+
+	// Rotating back onto the current map: its package is the live world, which
+	// must not be held across travel. Content and manifest still preload.
+	const UWorld* World = GetGameInstance()->GetWorld();
+	const bool bIsCurrentMap = World && UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()) == MapPackageName;
+	if (!bIsCurrentMap)
+	{
+		bMapPackagePending = true;
+		LoadPackageAsync(MapPackageName, FLoadPackageAsyncDelegate::CreateUObject(this, &UGoombanicsMapPreloadSubsystem::OnMapPackageLoaded));
+	}
+
+	TArray<FSoftObjectPath> Assets;
+	if (!Entry.KaijuPawnClass.IsNull())
+	{
+		Assets.Add(Entry.KaijuPawnClass.ToSoftObjectPath());
+	}
+	for (const TSoftObjectPtr<UObject>& Asset : Entry.WeaponAssets)
+	{
+		if (!Asset.IsNull())
+		{
+			Assets.Add(Asset.ToSoftObjectPath());
+		}
+	}
+	const int32 NumAssets = Assets.Num();
+	if (NumAssets > 0)
+	{
+		bAssetsPending = true;
+		AssetsHandle = StreamableManager.RequestAsyncLoad(MoveTemp(Assets),
+			FStreamableDelegate::CreateUObject(this, &UGoombanicsMapPreloadSubsystem::OnAssetsLoaded));
+	}
+
+	ManifestFilename = FGoombanicsBreakableManifest::GetFilenameForMap(MapPackageName);
+	ManifestTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Filename = ManifestFilename]()
+	{
+		TSharedPtr<FGoombanicsBreakableManifest> Manifest = MakeShared<FGoombanicsBreakableManifest>();
+		if (!Manifest->LoadFromFile(Filename))
+		{
+			Manifest.Reset();
+		}
+		return Manifest;
+	});
+	bManifestTaskLaunched = true;
+
+	UE_LOG(LogGoombanics, Log, TEXT("MapPreload: preloading %s (%d assets)"), *MapPackageName, NumAssets);
+}
+
+bool UGoombanicsMapPreloadSubsystem::TakeManifest(const FString& Filename, FGoombanicsBreakableManifest& OutManifest)
+{
+	if (!bManifestTaskLaunched || Filename != ManifestFilename)
+	{
+		return false;
+	}
+
+	// Normally finished long before the round ended; waiting still beats a second read.
+	TSharedPtr<FGoombanicsBreakableManifest> Manifest = ManifestTask.GetResult();
+	ManifestTask = {};
+	ManifestFilename.Reset();
+	bManifestTaskLaunched = false;
+
+	if (!Manifest.IsValid())
+	{
+		return false;
+	}
+
+	OutManifest = MoveTemp(*Manifest);
+	return true;
+}
+
+bool UGoombanicsMapPreloadSubsystem::IsPreloadComplete() const
+{
+	return !PreloadedMapName.IsEmpty() && !bMapPackagePending && !bAssetsPending
+		&& (!bManifestTaskLaunched || ManifestTask.IsCompleted());
+}
+
+void UGoombanicsMapPreloadSubsystem::ReleasePreload()
+{
+	if (bManifestTaskLaunched)
+	{
+		ManifestTask.Wait();
+		ManifestTask = {};
+		bManifestTaskLaunched = false;
+	}
+	ManifestFilename.Reset();
+
+	if (AssetsHandle.IsValid())
+	{
+		AssetsHandle->CancelHandle();
+		AssetsHandle.Reset();
+	}
+
+	PreloadedWorld = nullptr;
+	PreloadedMapName.Reset();
+	bMapPackagePending = false;
+	bAssetsPending = false;
+}
+
+void UGoombanicsMapPreloadSubsystem::OnMapPackageLoaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+{
+	// A newer Preload may have replaced this one while it was in flight.
+	if (PackageName.ToString() != PreloadedMapName)
+	{
+		return;
+	}
+
+	bMapPackagePending = false;
+	PreloadedWorld = (Result == EAsyncLoadingResult::Succeeded && Package) ? UWorld::FindWorldInPackage(Package) : nullptr;
+
+	if (!PreloadedWorld)
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("MapPreload: failed to load %s; travel will load it"), *PreloadedMapName);
+		return;
+	}
+
+	UE_LOG(LogGoombanics, Log, TEXT("MapPreload: %s resident after %.1f ms"), *PreloadedMapName, (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+}
+
+void UGoombanicsMapPreloadSubsystem::OnAssetsLoaded()
+{
+	bAssetsPending = false;
+
+	UE_LOG(LogGoombanics, Log, TEXT("MapPreload: assets for %s resident after %.1f ms"), *PreloadedMapName, (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+}
+
+void UGoombanicsMapPreloadSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	// The transition map also lands here; only the destination releases the hold.
+	if (PreloadedWorld && LoadedWorld && UWorld::RemovePIEPrefix(LoadedWorld->GetOutermost()->GetName()) == PreloadedMapName)
+	{
+		PreloadedWorld = nullptr;
+	}
+}
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "Tasks/Task.h"
+#include "Goombanics/Data/GoombanicsMapRotationData.h"
+#include "Goombanics/Destruction/GoombanicsBreakableManifest.h"
+#include "GoombanicsMapPreloadSubsystem.generated.h"
+
+class UPackage;
+class UWorld;
+
+// -----------------------------------------------------------------------------
+// UGoombanicsMapPreloadSubsystem
+//
+// Warms the next map of the rotation while the end-of-round screen is up, so the
+// seamless travel that follows never waits on a load:
+// - the map package (async); its world is held until travel picks it up,
+// - the entry's Kaiju class and weapon assets (FStreamableManager),
+// - the map's breakable manifest, read on a UE::Tasks worker and handed to the
+//   destruction subsystem in place of its file read at begin play.
+// Lives on the game instance, so everything it holds survives the transition
+// map. Server and clients preload independently; clients learn the next map
+// from AGoombanicsGameState::NextMap. Asset handles are kept until the next
+// Preload, so at most one map's worth stays pinned.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API UGoombanicsMapPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGoombanicsMapPreloadSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Starts loading Entry's map and content. Repeated calls for the same map are ignored.
+	void Preload(const FGoombanicsMapRotationEntry& Entry);
+
+	// Moves the preloaded manifest for Filename into OutManifest. Returns false if
+	// none was preloaded for it (or the file was missing); the caller reads it then.
+	bool TakeManifest(const FString& Filename, FGoombanicsBreakableManifest& OutManifest);
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Rotation")
+	bool IsPreloadComplete() const;
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Rotation")
+	FString GetPreloadedMapName() const { return PreloadedMapName; }
+
+protected:
+	void ReleasePreload();
+	void OnMapPackageLoaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result);
+	void OnAssetsLoaded();
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	// Keeps the loaded (not yet initialized) world from being collected in the
+	// transition map; dropped once travel has made it the live world.
+	UPROPERTY(Transient)
+	TObjectPtr<UWorld> PreloadedWorld;
+
+	FStreamableManager StreamableManager;
+	TSharedPtr<FStreamableHandle> AssetsHandle;
+
+	UE::Tasks::TTask<TSharedPtr<FGoombanicsBreakableManifest>> ManifestTask;
+	FString ManifestFilename;
+	bool bManifestTaskLaunched = false;
+
+	FString PreloadedMapName;
+	FDelegateHandle PostLoadMapHandle;
+	double PreloadStartTime = 0.0;
+	bool bMapPackagePending = false;
+	bool bAssetsPending = false;
+};
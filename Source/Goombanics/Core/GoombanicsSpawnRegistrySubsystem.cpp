@@ -0,0 +1,306 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsSpawnRegistrySubsystem.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "NavigationSystem.h"
+
+namespace GoombanicsSpawnRegistry
+{
+	static const FName KaijuSpawnTag(TEXT("KaijuSpawn"));
+	static const FVector NavProjectionExtent(200.0f, 200.0f, 500.0f);
+}
+
+void UGoombanicsSpawnRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	RecentDeaths.SetNum(MaxRecentDeaths);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UGoombanicsSpawnRegistrySubsystem::OnLevelAddedToWorld);
+}
+
+void UGoombanicsSpawnRegistrySubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	PlayerStarts.Reset();
+	KaijuSpawns.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UGoombanicsSpawnRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGoombanicsSpawnRegistrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	EnsureBuilt();
+
+	// Navigation data is only guaranteed to be registered once the world begins play.
+	if (!bNavProjected)
+	{
+		ProjectToNavigation(PlayerStarts);
+		ProjectToNavigation(KaijuSpawns);
+		bNavProjected = true;
+	}
+}
+
+void UGoombanicsSpawnRegistrySubsystem::EnsureBuilt()
+{
+	if (!bBuilt)
+	{
+		RebuildRegistry();
+	}
+}
+
+void UGoombanicsSpawnRegistrySubsystem::RebuildRegistry()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	PlayerStarts.Reset();
+	KaijuSpawns.Reset();
+
+	// One walk per map load (or streamed level), instead of one per respawn.
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		const bool bIsPlayerStart = Actor->IsA<APlayerStart>();
+		const bool bIsKaijuSpawn = Actor->ActorHasTag(GoombanicsSpawnRegistry::KaijuSpawnTag);
+		if (!bIsPlayerStart && !bIsKaijuSpawn)
+		{
+			continue;
+		}
+
+		FSpawnPoint Point;
+		Point.Actor = Actor;
+		Point.Location = Actor->GetActorLocation();
+		Point.Rotation = Actor->GetActorRotation();
+
+		if (bIsPlayerStart)
+		{
+			PlayerStarts.Add(Point);
+		}
+		if (bIsKaijuSpawn)
+		{
+			KaijuSpawns.Add(Point);
+		}
+	}
+
+	bBuilt = true;
+
+	if (World->HasBegunPlay())
+	{
+		ProjectToNavigation(PlayerStarts);
+		ProjectToNavigation(KaijuSpawns);
+		bNavProjected = true;
+	}
+
+	UE_LOG(LogGoombanics, Log, TEXT("SpawnRegistry: cached %d player starts, %d Kaiju spawns"), PlayerStarts.Num(), KaijuSpawns.Num());
+}
+
+void UGoombanicsSpawnRegistrySubsystem::ProjectToNavigation(TArray<FSpawnPoint>& Points) const
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return;
+	}
+
+	for (FSpawnPoint& Point : Points)
+	{
+		FNavLocation NavLocation;
+		Point.bHasNavLocation = NavSys->ProjectPointToNavigation(Point.Location, NavLocation, GoombanicsSpawnRegistry::NavProjectionExtent);
+		Point.NavLocation = Point.bHasNavLocation ? NavLocation.Location : Point.Location;
+	}
+}
+
+void UGoombanicsSpawnRegistrySubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		bBuilt = false;
+		bNavProjected = false;
+	}
+}
+
+void UGoombanicsSpawnRegistrySubsystem::GatherLivingPawnLocations(TArray<FVector, TInlineAllocator<16>>& OutLocations) const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		const APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+		if (Pawn && !Pawn->IsHidden())
+		{
+			OutLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+}
+
+AActor* UGoombanicsSpawnRegistrySubsystem::ChoosePlayerStart(const FVector* ThreatLocation)
+{
+	EnsureBuilt();
+
+	if (PlayerStarts.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	TArray<FVector, TInlineAllocator<16>> PawnLocations;
+	GatherLivingPawnLocations(PawnLocations);
+
+	const float KaijuSafeDistSq = FMath::Square(FMath::Max(1.0f, Settings.KaijuSafeDistance));
+	const float DeathSafeDistSq = FMath::Square(FMath::Max(1.0f, Settings.RecentDeathSafeDistance));
+	const float OccupancyRadiusSq = FMath::Square(Settings.OccupancyRadius);
+
+	int32 BestIndex = INDEX_NONE;
+	float BestScore = -TNumericLimits<float>::Max();
+
+	for (int32 Index = 0; Index < PlayerStarts.Num(); ++Index)
+	{
+		const FSpawnPoint& Point = PlayerStarts[Index];
+		if (!Point.Actor.IsValid())
+		{
+			continue;
+		}
+
+		const FVector& Location = Point.NavLocation;
+		float Score = 0.0f;
+
+		if (ThreatLocation)
+		{
+			const float DistSq = FVector::DistSquared(Location, *ThreatLocation);
+			Score += Settings.KaijuDistanceWeight * FMath::Sqrt(FMath::Min(DistSq, KaijuSafeDistSq) / KaijuSafeDistSq);
+		}
+
+		float NearestDeathSq = DeathSafeDistSq;
+		for (const FRecentDeath& Death : RecentDeaths)
+		{
+			if (Death.bValid && Now - Death.Time <= Settings.RecentDeathWindow)
+			{
+				NearestDeathSq = FMath::Min(NearestDeathSq, static_cast<float>(FVector::DistSquared(Location, Death.Location)));
+			}
+		}
+		Score += Settings.RecentDeathWeight * FMath::Sqrt(NearestDeathSq / DeathSafeDistSq);
+
+		// Tested where the pawn would actually be placed (see GetSpawnTransform).
+		bool bOccupied = Point.ReservedUntil > Now;
+		for (int32 PawnIndex = 0; PawnIndex < PawnLocations.Num() && !bOccupied; ++PawnIndex)
+		{
+			bOccupied = FVector::DistSquared(Location, PawnLocations[PawnIndex]) < OccupancyRadiusSq;
+		}
+		if (bOccupied)
+		{
+			Score -= Settings.OccupiedPenalty;
+		}
+
+		Score += FMath::FRand() * Settings.RandomJitter;
+
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestIndex = Index;
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	FSpawnPoint& Chosen = PlayerStarts[BestIndex];
+	Chosen.ReservedUntil = Now + Settings.ReservationDuration;
+	return Chosen.Actor.Get();
+}
+
+AActor* UGoombanicsSpawnRegistrySubsystem::ChooseKaijuSpawn()
+{
+	EnsureBuilt();
+
+	TArray<FVector, TInlineAllocator<16>> PawnLocations;
+	GatherLivingPawnLocations(PawnLocations);
+
+	AActor* BestActor = nullptr;
+	float BestNearestSq = -1.0f;
+
+	for (const FSpawnPoint& Point : KaijuSpawns)
+	{
+		if (!Point.Actor.IsValid())
+		{
+			continue;
+		}
+
+		float NearestSq = TNumericLimits<float>::Max();
+		for (const FVector& PawnLocation : PawnLocations)
+		{
+			NearestSq = FMath::Min(NearestSq, static_cast<float>(FVector::DistSquared(Point.NavLocation, PawnLocation)));
+		}
+
+		if (NearestSq > BestNearestSq)
+		{
+			BestNearestSq = NearestSq;
+			BestActor = Point.Actor.Get();
+		}
+	}
+
+	return BestActor;
+}
+
+const UGoombanicsSpawnRegistrySubsystem::FSpawnPoint* UGoombanicsSpawnRegistrySubsystem::FindSpawnPoint(const AActor* SpawnPoint) const
+{
+	for (const FSpawnPoint& Point : PlayerStarts)
+	{
+		if (Point.Actor.Get() == SpawnPoint)
+		{
+			return &Point;
+		}
+	}
+
+	for (const FSpawnPoint& Point : KaijuSpawns)
+	{
+		if (Point.Actor.Get() == SpawnPoint)
+		{
+			return &Point;
+		}
+	}
+
+	return nullptr;
+}
+
+FTransform UGoombanicsSpawnRegistrySubsystem::GetSpawnTransform(const AActor* SpawnPoint, float CapsuleHalfHeight) const
+{
+	if (!SpawnPoint)
+	{
+		return FTransform::Identity;
+	}
+
+	const FSpawnPoint* Point = FindSpawnPoint(SpawnPoint);
+	if (!Point || !Point->bHasNavLocation)
+	{
+		return SpawnPoint->GetActorTransform();
+	}
+
+	const FRotator YawOnly(0.0f, Point->Rotation.Yaw, 0.0f);
+	return FTransform(YawOnly, Point->NavLocation + FVector(0.0f, 0.0f, CapsuleHalfHeight));
+}
+
+void UGoombanicsSpawnRegistrySubsystem::RecordDeath(const FVector& Location)
+{
+	FRecentDeath& Slot = RecentDeaths[NextDeathSlot];
+	Slot.Location = Location;
+	Slot.Time = GetWorld()->GetTimeSeconds();
+	Slot.bValid = true;
+	NextDeathSlot = (NextDeathSlot + 1) % MaxRecentDeaths;
+}
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GoombanicsSpawnRegistrySubsystem.generated.h"
+
+class ULevel;
+
+USTRUCT(BlueprintType)
+struct FGoombanicsSpawnScoringSettings
+{
+	GENERATED_BODY()
+
+	// Distance from the Kaiju at which a spawn is considered fully safe.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float KaijuSafeDistance = 4000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float KaijuDistanceWeight = 1.0f;
+
+	// Distance from a recent death at which a spawn is no longer penalized.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float RecentDeathSafeDistance = 2000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float RecentDeathWeight = 0.5f;
+
+	// Deaths older than this no longer influence scoring.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float RecentDeathWindow = 10.0f;
+
+	// A living pawn within this radius marks the spawn as occupied.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float OccupancyRadius = 150.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float OccupiedPenalty = 10.0f;
+
+	// How long a chosen spawn stays reserved so simultaneous respawns pick different points.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float ReservationDuration = 1.5f;
+
+	// Small random term so equally scored points don't always resolve the same way.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Spawn")
+	float RandomJitter = 0.05f;
+};
+
+// -----------------------------------------------------------------------------
+// UGoombanicsSpawnRegistrySubsystem
+//
+// Caches PlayerStarts and "KaijuSpawn"-tagged actors once per map (rebuilt only when
+// a streaming level is added), with nav projections precomputed at BeginPlay.
+// Respawn queries are then a short scoring loop over the cache instead of an
+// actor-list walk per respawn.
+//
+// Server-only in practice: GameMode is the only caller.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API UGoombanicsSpawnRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	void SetScoringSettings(const FGoombanicsSpawnScoringSettings& InSettings) { Settings = InSettings; }
+
+	// Picks the best scored PlayerStart and reserves it. ThreatLocation is usually the Kaiju.
+	AActor* ChoosePlayerStart(const FVector* ThreatLocation);
+
+	// Picks the Kaiju spawn farthest from living players (first cached one if none).
+	AActor* ChooseKaijuSpawn();
+
+	// Spawn transform for a cached point: nav-projected location raised by CapsuleHalfHeight,
+	// falling back to the actor transform when no projection is available.
+	FTransform GetSpawnTransform(const AActor* SpawnPoint, float CapsuleHalfHeight) const;
+
+	void RecordDeath(const FVector& Location);
+
+	int32 GetNumPlayerStarts() const { return PlayerStarts.Num(); }
+	int32 GetNumKaijuSpawns() const { return KaijuSpawns.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	struct FSpawnPoint
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		FVector NavLocation = FVector::ZeroVector;
+		bool bHasNavLocation = false;
+		double ReservedUntil = 0.0;
+	};
+
+	struct FRecentDeath
+	{
+		FVector Location = FVector::ZeroVector;
+		double Time = 0.0;
+		bool bValid = false;
+	};
+
+	void EnsureBuilt();
+	void RebuildRegistry();
+	void ProjectToNavigation(TArray<FSpawnPoint>& Points) const;
+	void GatherLivingPawnLocations(TArray<FVector, TInlineAllocator<16>>& OutLocations) const;
+	const FSpawnPoint* FindSpawnPoint(const AActor* SpawnPoint) const;
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+	TArray<FSpawnPoint> PlayerStarts;
+	TArray<FSpawnPoint> KaijuSpawns;
+
+	static constexpr int32 MaxRecentDeaths = 16;
+	TArray<FRecentDeath> RecentDeaths;
+	int32 NextDeathSlot = 0;
+
+	FGoombanicsSpawnScoringSettings Settings;
+	FDelegateHandle LevelAddedHandle;
+	bool bBuilt = false;
+	bool bNavProjected = false;
+};
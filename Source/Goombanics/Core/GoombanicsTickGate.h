@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+
+// -----------------------------------------------------------------------------
+// FGoombanicsTickGate
+//
+// Tick-on-demand helper. Owners register with bStartWithTickEnabled = false and
+// raise a reason bit whenever they have per-frame work (dashing, holding fire,
+// running a match timer). The tick function is enabled while any reason is set
+// and disabled as soon as the last one clears, so idle objects cost nothing.
+//
+// Reasons are owner-defined bits; keep them in an enum next to the owner. The top
+// bit is reserved for Blueprint subclasses that implement Event Tick: owners call
+// KeepTickingForBlueprint at BeginPlay so the gate never switches that tick off.
+// Native per-frame work must still check its own state, not just "am I ticking".
+// -----------------------------------------------------------------------------
+struct FGoombanicsTickGate
+{
+	template <typename TickTarget>
+	void SetReason(TickTarget* Target, uint32 Reason, bool bActive)
+	{
+		const bool bWasActive = IsActive();
+		Reasons = bActive ? (Reasons | Reason) : (Reasons & ~Reason);
+
+		if (Target && bWasActive != IsActive())
+		{
+			ApplyTickEnabled(Target, IsActive());
+		}
+	}
+
+	// Raises ReasonBlueprintTick for good if Target's class implements Event Tick.
+	template <typename TickTarget>
+	void KeepTickingForBlueprint(TickTarget* Target)
+	{
+		if (Target && ImplementsBlueprintTick(Target))
+		{
+			SetReason(Target, ReasonBlueprintTick, true);
+		}
+	}
+
+	bool IsActive() const { return Reasons != 0; }
+	bool HasReason(uint32 Reason) const { return (Reasons & Reason) != 0; }
+
+	static constexpr uint32 ReasonBlueprintTick = 1u << 31;
+
+private:
+	static void ApplyTickEnabled(AActor* Actor, bool bEnabled) { Actor->SetActorTickEnabled(bEnabled); }
+	static void ApplyTickEnabled(UActorComponent* Component, bool bEnabled) { Component->SetComponentTickEnabled(bEnabled); }
+
+	static bool ImplementsBlueprintTick(const AActor* Actor)
+	{
+		return Actor->GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AActor, ReceiveTick));
+	}
+	static bool ImplementsBlueprintTick(const UActorComponent* Component)
+	{
+		return Component->GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UActorComponent, ReceiveTick));
+	}
+
+	uint32 Reasons = 0;
+};
@@ -0,0 +1,349 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsTimerWheelSubsystem.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UGoombanicsTimerWheelSubsystem* UGoombanicsTimerWheelSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGoombanicsTimerWheelSubsystem>() : nullptr;
+}
+
+FGoombanicsTimerHandle UGoombanicsTimerWheelSubsystem::ScheduleTimer(const UObject* WorldContextObject, float DelaySeconds, FSimpleDelegate Callback)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (!ensureMsgf(World, TEXT("ScheduleTimer: %s has no world, timer dropped"), *GetNameSafe(WorldContextObject)))
+	{
+		return FGoombanicsTimerHandle();
+	}
+
+	if (UGoombanicsTimerWheelSubsystem* Timers = World->GetSubsystem<UGoombanicsTimerWheelSubsystem>())
+	{
+		return Timers->Schedule(DelaySeconds, MoveTemp(Callback));
+	}
+
+	UE_LOG(LogGoombanics, Verbose, TEXT("ScheduleTimer: no timer wheel in %s, using the timer manager"), *World->GetName());
+
+	// A non-positive rate would clear the timer instead of firing it; the wheel
+	// rounds up to one tick in the same case.
+	FGoombanicsTimerHandle Handle;
+	World->GetTimerManager().SetTimer(Handle.FallbackHandle, MoveTemp(Callback), FMath::Max(DelaySeconds, TickInterval), false);
+	return Handle;
+}
+
+void UGoombanicsTimerWheelSubsystem::CancelTimer(const UObject* WorldContextObject, FGoombanicsTimerHandle& Handle)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (World)
+	{
+		if (Handle.FallbackHandle.IsValid())
+		{
+			World->GetTimerManager().ClearTimer(Handle.FallbackHandle);
+		}
+		else if (UGoombanicsTimerWheelSubsystem* Timers = World->GetSubsystem<UGoombanicsTimerWheelSubsystem>())
+		{
+			Timers->Cancel(Handle);
+		}
+	}
+	Handle.Invalidate();
+}
+
+bool UGoombanicsTimerWheelSubsystem::IsTimerActive(const UObject* WorldContextObject, const FGoombanicsTimerHandle& Handle)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (!World)
+	{
+		return false;
+	}
+
+	if (Handle.FallbackHandle.IsValid())
+	{
+		return World->GetTimerManager().IsTimerActive(Handle.FallbackHandle);
+	}
+
+	const UGoombanicsTimerWheelSubsystem* Timers = World->GetSubsystem<UGoombanicsTimerWheelSubsystem>();
+	return Timers && Timers->IsActive(Handle);
+}
+
+float UGoombanicsTimerWheelSubsystem::GetTimerRemaining(const UObject* WorldContextObject, const FGoombanicsTimerHandle& Handle)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (!World)
+	{
+		return 0.0f;
+	}
+
+	if (Handle.FallbackHandle.IsValid())
+	{
+		return FMath::Max(0.0f, World->GetTimerManager().GetTimerRemaining(Handle.FallbackHandle));
+	}
+
+	const UGoombanicsTimerWheelSubsystem* Timers = World->GetSubsystem<UGoombanicsTimerWheelSubsystem>();
+	return Timers ? Timers->GetTimeRemaining(Handle) : 0.0f;
+}
+
+void UGoombanicsTimerWheelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (int32& Head : BucketHeads)
+	{
+		Head = INDEX_NONE;
+	}
+
+	Entries.Reserve(128);
+}
+
+void UGoombanicsTimerWheelSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	FreeEntries.Empty();
+	NumActive = 0;
+
+	Super::Deinitialize();
+}
+
+bool UGoombanicsTimerWheelSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UGoombanicsTimerWheelSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGoombanicsTimerWheelSubsystem, STATGROUP_Tickables);
+}
+
+void UGoombanicsTimerWheelSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Accumulator += DeltaTime;
+	while (Accumulator >= TickInterval)
+	{
+		Accumulator -= TickInterval;
+		ProcessTick();
+	}
+}
+
+FGoombanicsTimerHandle UGoombanicsTimerWheelSubsystem::Schedule(float DelaySeconds, FSimpleDelegate Callback)
+{
+	FGoombanicsTimerHandle Handle;
+	if (!Callback.IsBound())
+	{
+		return Handle;
+	}
+
+	static constexpr uint64 MaxDeltaTicks = (uint64(1) << (SlotBits * NumLevels)) - 1;
+
+	// Time already accumulated toward the next wheel tick counts against the delay.
+	const float TicksFloat = FMath::Max(0.0f, DelaySeconds + Accumulator) / TickInterval;
+	const uint64 DelayTicks = FMath::Clamp<uint64>(static_cast<uint64>(FMath::CeilToDouble(TicksFloat)), 1, MaxDeltaTicks);
+
+	int32 EntryIndex;
+	if (FreeEntries.Num() > 0)
+	{
+		EntryIndex = FreeEntries.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		EntryIndex = Entries.AddDefaulted();
+	}
+
+	uint32 Serial = NextSerial++;
+	if (Serial == 0)
+	{
+		Serial = NextSerial++;
+	}
+
+	FTimerEntry& Entry = Entries[EntryIndex];
+	Entry.Callback = MoveTemp(Callback);
+	Entry.ExpireTick = NextTick + DelayTicks - 1;
+	Entry.Serial = Serial;
+	Link(EntryIndex);
+	++NumActive;
+
+	Handle.Index = EntryIndex;
+	Handle.Serial = Serial;
+	return Handle;
+}
+
+void UGoombanicsTimerWheelSubsystem::Cancel(FGoombanicsTimerHandle& Handle)
+{
+	if (FindEntry(Handle))
+	{
+		Unlink(Handle.Index);
+		Release(Handle.Index);
+	}
+	Handle.Invalidate();
+}
+
+bool UGoombanicsTimerWheelSubsystem::IsActive(const FGoombanicsTimerHandle& Handle) const
+{
+	return FindEntry(Handle) != nullptr;
+}
+
+float UGoombanicsTimerWheelSubsystem::GetTimeRemaining(const FGoombanicsTimerHandle& Handle) const
+{
+	const FTimerEntry* Entry = FindEntry(Handle);
+	if (!Entry)
+	{
+		return 0.0f;
+	}
+
+	const uint64 TicksUntilFire = Entry->ExpireTick - NextTick + 1;
+	return FMath::Max(0.0f, static_cast<float>(TicksUntilFire) * TickInterval - Accumulator);
+}
+
+const UGoombanicsTimerWheelSubsystem::FTimerEntry* UGoombanicsTimerWheelSubsystem::FindEntry(const FGoombanicsTimerHandle& Handle) const
+{
+	if (!Handle.IsValid() || !Entries.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	const FTimerEntry& Entry = Entries[Handle.Index];
+	return Entry.Serial == Handle.Serial ? &Entry : nullptr;
+}
+
+void UGoombanicsTimerWheelSubsystem::Link(int32 EntryIndex)
+{
+	FTimerEntry& Entry = Entries[EntryIndex];
+	const uint64 Delta = Entry.ExpireTick - NextTick;
+
+	// Pick the finest level whose span still covers the delay.
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && Delta >= (uint64(1) << (SlotBits * (Level + 1))))
+	{
+		++Level;
+	}
+
+	const int32 Slot = static_cast<int32>((Entry.ExpireTick >> (SlotBits * Level)) & SlotMask);
+	const int32 Bucket = Level * SlotsPerLevel + Slot;
+
+	Entry.Bucket = static_cast<int16>(Bucket);
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = BucketHeads[Bucket];
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = EntryIndex;
+	}
+	BucketHeads[Bucket] = EntryIndex;
+}
+
+void UGoombanicsTimerWheelSubsystem::Unlink(int32 EntryIndex)
+{
+	FTimerEntry& Entry = Entries[EntryIndex];
+	if (Entry.Bucket == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		BucketHeads[Entry.Bucket] = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+	Entry.Bucket = INDEX_NONE;
+}
+
+void UGoombanicsTimerWheelSubsystem::Release(int32 EntryIndex)
+{
+	FTimerEntry& Entry = Entries[EntryIndex];
+	Entry.Callback.Unbind();
+	Entry.Serial = 0;
+	FreeEntries.Push(EntryIndex);
+	--NumActive;
+}
+
+void UGoombanicsTimerWheelSubsystem::Cascade(int32 Level)
+{
+	const int32 Slot = static_cast<int32>((NextTick >> (SlotBits * Level)) & SlotMask);
+	const int32 Bucket = Level * SlotsPerLevel + Slot;
+
+	int32 EntryIndex = BucketHeads[Bucket];
+	BucketHeads[Bucket] = INDEX_NONE;
+
+	while (EntryIndex != INDEX_NONE)
+	{
+		const int32 Next = Entries[EntryIndex].Next;
+		Link(EntryIndex);
+		EntryIndex = Next;
+	}
+}
+
+void UGoombanicsTimerWheelSubsystem::ProcessTick()
+{
+	const uint64 Tick = NextTick;
+
+	// Entering a new level-0 rotation: pull the matching coarser slots down, stopping
+	// at the first level that is not also wrapping.
+	if ((Tick & SlotMask) == 0)
+	{
+		for (int32 Level = 1; Level < NumLevels; ++Level)
+		{
+			Cascade(Level);
+			if (((Tick >> (SlotBits * Level)) & SlotMask) != 0)
+			{
+				break;
+			}
+		}
+	}
+
+	const int32 Bucket = static_cast<int32>(Tick & SlotMask);
+	if (BucketHeads[Bucket] == INDEX_NONE)
+	{
+		++NextTick;
+		return;
+	}
+
+	// Detach the expiring list first: callbacks may schedule or cancel freely.
+	struct FExpired
+	{
+		int32 Index;
+		uint32 Serial;
+	};
+	TArray<FExpired, TInlineAllocator<32>> Expired;
+
+	int32 EntryIndex = BucketHeads[Bucket];
+	BucketHeads[Bucket] = INDEX_NONE;
+	while (EntryIndex != INDEX_NONE)
+	{
+		FTimerEntry& Entry = Entries[EntryIndex];
+		const int32 Next = Entry.Next;
+		Entry.Prev = INDEX_NONE;
+		Entry.Next = INDEX_NONE;
+		Entry.Bucket = INDEX_NONE;
+		Expired.Add({ EntryIndex, Entry.Serial });
+		EntryIndex = Next;
+	}
+
+	++NextTick;
+
+	for (const FExpired& Item : Expired)
+	{
+		FTimerEntry& Entry = Entries[Item.Index];
+		if (Entry.Serial != Item.Serial)
+		{
+			// Cancelled by an earlier callback in this batch.
+			continue;
+		}
+
+		FSimpleDelegate Callback = MoveTemp(Entry.Callback);
+		Release(Item.Index);
+		Callback.ExecuteIfBound();
+	}
+}
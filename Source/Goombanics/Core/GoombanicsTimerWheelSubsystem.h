@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TimerHandle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GoombanicsTimerWheelSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FGoombanicsTimerHandle
+{
+	GENERATED_BODY()
+
+	bool IsValid() const { return Serial != 0 || FallbackHandle.IsValid(); }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; FallbackHandle.Invalidate(); }
+
+	bool operator==(const FGoombanicsTimerHandle& Other) const
+	{
+		return Index == Other.Index && Serial == Other.Serial && FallbackHandle == Other.FallbackHandle;
+	}
+
+private:
+	friend class UGoombanicsTimerWheelSubsystem;
+
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	// Set instead of Index/Serial when the timer went to the world's FTimerManager.
+	FTimerHandle FallbackHandle;
+};
+
+// -----------------------------------------------------------------------------
+// UGoombanicsTimerWheelSubsystem
+//
+// Hierarchical timer wheel for gameplay countdowns (cooldowns, reloads, dash,
+// stagger, respawns). Expirations are events: an actor whose only per-frame work
+// was decrementing a float no longer needs to tick at all.
+//
+// - Fixed resolution of TickInterval seconds (game time, pauses with the world).
+// - NumLevels wheels of SlotsPerLevel slots; far timers cascade down as time advances.
+// - Schedule/Cancel are O(1); advancing a tick is O(expiring timers) plus an
+//   occasional cascade of one slot.
+// - Callbacks bound with CreateUObject/CreateWeakLambda are skipped if their
+//   object was destroyed.
+// - Gameplay code goes through the static ScheduleTimer/CancelTimer helpers, which
+//   fall back to the world's FTimerManager when the wheel is not available (world
+//   types it does not support, teardown) so a timer is never silently dropped.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API UGoombanicsTimerWheelSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGoombanicsTimerWheelSubsystem* Get(const UObject* WorldContextObject);
+
+	// Schedules on the wheel of WorldContextObject's world, or on its FTimerManager
+	// if there is no wheel. Returns an invalid handle only if there is no world at all.
+	static FGoombanicsTimerHandle ScheduleTimer(const UObject* WorldContextObject, float DelaySeconds, FSimpleDelegate Callback);
+
+	// Counterparts of Cancel/IsActive/GetTimeRemaining for handles from ScheduleTimer.
+	static void CancelTimer(const UObject* WorldContextObject, FGoombanicsTimerHandle& Handle);
+	static bool IsTimerActive(const UObject* WorldContextObject, const FGoombanicsTimerHandle& Handle);
+	static float GetTimerRemaining(const UObject* WorldContextObject, const FGoombanicsTimerHandle& Handle);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Schedules Callback to run once after DelaySeconds (rounded up to whole wheel ticks).
+	FGoombanicsTimerHandle Schedule(float DelaySeconds, FSimpleDelegate Callback);
+
+	// Cancels the timer if it is still pending and invalidates the handle.
+	void Cancel(FGoombanicsTimerHandle& Handle);
+
+	bool IsActive(const FGoombanicsTimerHandle& Handle) const;
+
+	// Seconds until the timer fires, or 0 if it is not pending.
+	float GetTimeRemaining(const FGoombanicsTimerHandle& Handle) const;
+
+	int32 GetNumActiveTimers() const { return NumActive; }
+
+	static constexpr float TickInterval = 1.0f / 60.0f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+	static constexpr int32 SlotMask = SlotsPerLevel - 1;
+	static constexpr int32 NumLevels = 4;
+
+	struct FTimerEntry
+	{
+		FSimpleDelegate Callback;
+		uint64 ExpireTick = 0;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		uint32 Serial = 0;
+		int16 Bucket = INDEX_NONE;
+	};
+
+	void ProcessTick();
+	void Cascade(int32 Level);
+	void Link(int32 EntryIndex);
+	void Unlink(int32 EntryIndex);
+	void Release(int32 EntryIndex);
+	const FTimerEntry* FindEntry(const FGoombanicsTimerHandle& Handle) const;
+
+	TArray<FTimerEntry> Entries;
+	TArray<int32> FreeEntries;
+
+	// Head entry per bucket, bucket = Level * SlotsPerLevel + Slot.
+	int32 BucketHeads[NumLevels * SlotsPerLevel];
+
+	// Next wheel tick to be processed.
+	uint64 NextTick = 0;
+	float Accumulator = 0.0f;
+	uint32 NextSerial = 1;
+	int32 NumActive = 0;
+};
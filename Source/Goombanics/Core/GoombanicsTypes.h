@@ -60,7 +60,8 @@ enum class EGoombanicsMatchEndReason : uint8
 	None				UMETA(DisplayName = "None"),
 	KaijuDefeated		UMETA(DisplayName = "Kaiju Defeated"),
 	CityDestroyed		UMETA(DisplayName = "City Destroyed"),
-	TimerExpired		UMETA(DisplayName = "Timer Expired")
+	TimerExpired		UMETA(DisplayName = "Timer Expired"),
+	ProtectedDistrictDestroyed	UMETA(DisplayName = "Protected District Destroyed")
 };
 
 USTRUCT(BlueprintType)
@@ -103,6 +104,77 @@ enum class EGoombanicsAwardType : uint8
 	WorstDayEver		UMETA(DisplayName = "Worst Day Ever")
 };
 
+// Stat keys readable by the award engine. Each key is one column of the packed
+// stats table built at end of round; adding a key here (and to
+// FGoombanicsPlayerScoreData::GetStatValue) makes it available to every award.
+UENUM(BlueprintType)
+enum class EGoombanicsStatKey : uint8
+{
+	KaijuDamageDealt		UMETA(DisplayName = "Kaiju Damage Dealt"),
+	CollateralDamageScore	UMETA(DisplayName = "Collateral Damage Score"),
+	WeakPointsDestroyed		UMETA(DisplayName = "Weak Points Destroyed"),
+	Deaths					UMETA(DisplayName = "Deaths"),
+	FinalBlowCount			UMETA(DisplayName = "Final Blow Count"),
+	TotalScore				UMETA(DisplayName = "Total Score"),
+	Count					UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EGoombanicsAwardComparator : uint8
+{
+	Highest		UMETA(DisplayName = "Highest"),
+	Lowest		UMETA(DisplayName = "Lowest")
+};
+
+UENUM(BlueprintType)
+enum class EGoombanicsAwardTieBreak : uint8
+{
+	// Earliest PlayerState in PlayerArray keeps the award (legacy behaviour).
+	FirstListed			UMETA(DisplayName = "First Listed"),
+	FewestDeaths		UMETA(DisplayName = "Fewest Deaths"),
+	HighestTotalScore	UMETA(DisplayName = "Highest Total Score"),
+	// A tie for the best value leaves the award unclaimed.
+	NoWinner			UMETA(DisplayName = "No Winner")
+};
+
+// One award as data. Evaluated by FGoombanicsAwardEngine in a single pass over
+// the packed stats table, so adding awards does not add code or per-player fields.
+USTRUCT(BlueprintType)
+struct FGoombanicsAwardDefinition
+{
+	GENERATED_BODY()
+
+	// Stable identifier for UI lookups (title/icon tables).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Awards")
+	FName AwardId = NAME_None;
+
+	// Legacy category used by existing UI bindings.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Awards")
+	EGoombanicsAwardType AwardType = EGoombanicsAwardType::MostKaijuDamage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Awards")
+	EGoombanicsStatKey StatKey = EGoombanicsStatKey::TotalScore;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Awards")
+	EGoombanicsAwardComparator Comparator = EGoombanicsAwardComparator::Highest;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Awards")
+	EGoombanicsAwardTieBreak TieBreak = EGoombanicsAwardTieBreak::FirstListed;
+
+	// Roles allowed to compete (bit per EGoombanicsRole value).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Awards", meta = (Bitmask, BitmaskEnum = "/Script/Goombanics.EGoombanicsRole"))
+	int32 RoleFilter = 0x7;
+
+	// If no player matches RoleFilter, let every role compete instead.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Awards")
+	bool bFallbackToAnyRole = false;
+
+	static int32 MakeRoleMask(EGoombanicsRole Role)
+	{
+		return 1 << static_cast<uint8>(Role);
+	}
+};
+
 USTRUCT(BlueprintType)
 struct FGoombanicsAwardResult
 {
@@ -111,6 +183,9 @@ struct FGoombanicsAwardResult
 	UPROPERTY(BlueprintReadOnly, Category = "Awards")
 	EGoombanicsAwardType AwardType = EGoombanicsAwardType::MostKaijuDamage;
 
+	UPROPERTY(BlueprintReadOnly, Category = "Awards")
+	FName AwardId = NAME_None;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Awards")
 	FString WinnerPlayerName;
 
@@ -206,6 +281,27 @@ struct FGoombanicsPlayerScoreData
 			- (Deaths * Weights.DeathPenalty);
 		TotalScore = FMath::Max(0.0f, TotalScore);
 	}
+
+	float GetStatValue(EGoombanicsStatKey Key) const
+	{
+		switch (Key)
+		{
+		case EGoombanicsStatKey::KaijuDamageDealt:
+			return KaijuDamageDealt;
+		case EGoombanicsStatKey::CollateralDamageScore:
+			return CollateralDamageScore;
+		case EGoombanicsStatKey::WeakPointsDestroyed:
+			return static_cast<float>(WeakPointsDestroyed);
+		case EGoombanicsStatKey::Deaths:
+			return static_cast<float>(Deaths);
+		case EGoombanicsStatKey::FinalBlowCount:
+			return static_cast<float>(FinalBlowCount);
+		case EGoombanicsStatKey::TotalScore:
+			return TotalScore;
+		default:
+			return 0.0f;
+		}
+	}
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMatchPhaseChanged, EGoombanicsMatchPhase, NewPhase);
@@ -54,8 +54,17 @@ struct FGoombanicsScoreMultipliers
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Score")
 	float WeakPointDuringStaggerMultiplier = 1.25f;
 
+	// Applied to a player's collateral score while they are on a destruction chain.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Score")
 	float CollateralChainMultiplier = 1.15f;
+
+	// Max gap (seconds) between a player's breaks for the chain to continue.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Score", meta = (ClampMin = "0.0"))
+	float CollateralChainWindow = 1.5f;
+
+	// Breaks needed in one chain before CollateralChainMultiplier applies.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Score", meta = (ClampMin = "1"))
+	int32 CollateralChainMinBreaks = 5;
 };
 
 UCLASS(BlueprintType)
@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsMapRotationData.h"
+#include "Engine/World.h"
+
+int32 UGoombanicsMapRotationDataAsset::FindIndex(const FString& MapPackageName) const
+{
+	const FString PackageName = UWorld::RemovePIEPrefix(MapPackageName);
+	return Maps.IndexOfByPredicate([&PackageName](const FGoombanicsMapRotationEntry& Entry)
+	{
+		return Entry.IsValid() && Entry.Map.GetLongPackageName() == PackageName;
+	});
+}
+
+const FGoombanicsMapRotationEntry* UGoombanicsMapRotationDataAsset::FindEntry(const FString& MapPackageName) const
+{
+	const int32 Index = FindIndex(MapPackageName);
+	return Maps.IsValidIndex(Index) ? &Maps[Index] : nullptr;
+}
+
+const FGoombanicsMapRotationEntry* UGoombanicsMapRotationDataAsset::FindNextEntry(const FString& MapPackageName) const
+{
+	const int32 Current = FindIndex(MapPackageName);
+	for (int32 Step = 1; Step <= Maps.Num(); ++Step)
+	{
+		// Not listed (INDEX_NONE) starts the walk at entry 0.
+		const int32 Index = (Current + Step + Maps.Num()) % Maps.Num();
+		if (Maps[Index].IsValid())
+		{
+			return &Maps[Index];
+		}
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GoombanicsMapRotationData.generated.h"
+
+class AGoombanicsKaijuPawn;
+class UWorld;
+
+// One map of the rotation and the content its round needs up front. Soft
+// references only: nothing here loads until the map is next in line.
+USTRUCT(BlueprintType)
+struct FGoombanicsMapRotationEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Rotation")
+	TSoftObjectPtr<UWorld> Map;
+
+	// Kaiju for this map; unset uses the GameMode's KaijuPawnClass.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Rotation")
+	TSoftClassPtr<AGoombanicsKaijuPawn> KaijuPawnClass;
+
+	// Weapon tuning assets, projectile Blueprints and their FX used by this map's loadouts.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Rotation")
+	TArray<TSoftObjectPtr<UObject>> WeaponAssets;
+
+	bool IsValid() const { return !Map.IsNull(); }
+};
+
+// -----------------------------------------------------------------------------
+// UGoombanicsMapRotationDataAsset
+//
+// Ordered map list for AGoombanicsGameMode::MapRotation. After a round the
+// GameMode travels (seamlessly) to the entry after the current map, wrapping at
+// the end; a current map that is not listed continues with the first entry.
+// -----------------------------------------------------------------------------
+UCLASS(BlueprintType)
+class GOOMBANICS_API UGoombanicsMapRotationDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Rotation")
+	TArray<FGoombanicsMapRotationEntry> Maps;
+
+	// Entry for a map package (PIE prefixes ignored), or nullptr if not in the rotation.
+	const FGoombanicsMapRotationEntry* FindEntry(const FString& MapPackageName) const;
+
+	// Entry to travel to after MapPackageName, or nullptr if the rotation is empty.
+	const FGoombanicsMapRotationEntry* FindNextEntry(const FString& MapPackageName) const;
+
+protected:
+	int32 FindIndex(const FString& MapPackageName) const;
+};
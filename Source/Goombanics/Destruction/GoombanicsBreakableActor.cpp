@@ -1,11 +1,32 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GoombanicsBreakableActor.h"
+#include "GoombanicsDestructionSubsystem.h"
+#include "GoombanicsDestructionNavSubsystem.h"
 #include "Goombanics/Core/GoombanicsGameState.h"
 #include "Goombanics/Goombanics.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
+#include "NavModifierComponent.h"
+#include "NavAreas/NavArea_Default.h"
+#include "NavAreas/NavArea_Null.h"
 #include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarBreakablesUseDormancy(
+	TEXT("goombanics.Breakables.UseDormancy"),
+	true,
+	TEXT("Individually replicated breakables start dormant and wake only to send their broken state.\n")
+	TEXT("Read when a breakable begins play."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarBreakablesReplicateIndividually(
+	TEXT("goombanics.Breakables.ReplicateIndividually"),
+	false,
+	TEXT("Give every breakable actor its own channel instead of relying on the destruction bitset.\n")
+	TEXT("Profiling baseline only; set on server and clients before the map loads."),
+	ECVF_Default);
 
 AGoombanicsBreakableActor::AGoombanicsBreakableActor()
 {
@@ -14,29 +35,215 @@ AGoombanicsBreakableActor::AGoombanicsBreakableActor()
 	CollisionComponent = CreateDefaultSubobject<UBoxComponent>(TEXT("CollisionComponent"));
 	CollisionComponent->SetBoxExtent(FVector(50.0f, 50.0f, 100.0f));
 	CollisionComponent->SetCollisionProfileName(TEXT("BlockAll"));
+	CollisionComponent->SetCanEverAffectNavigation(false);
 	RootComponent = CollisionComponent;
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
 	MeshComponent->SetupAttachment(RootComponent);
 	MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeshComponent->SetCanEverAffectNavigation(false);
+
+	// The navmesh sees this prop only through the modifier, so hiding it or turning
+	// its collision off never dirties navigation; a break changes the area instead.
+	IntactNavArea = UNavArea_Null::StaticClass();
+	NavModifier = CreateDefaultSubobject<UNavModifierComponent>(TEXT("NavModifier"));
+	NavModifier->SetAreaClass(IntactNavArea);
+	NavModifier->FailsafeExtent = CollisionComponent->GetUnscaledBoxExtent();
 
-	bReplicates = true;
+	// Broken state replicates through the destruction manager's bitset, not per prop.
+	// Placed props that need their own channel get bReplicates from bReplicateIndividually
+	// at construction/load, so server and clients agree when the level loads; props
+	// spawned at runtime are switched on by the server in BeginPlay.
+	bReplicates = false;
+}
+
+void AGoombanicsBreakableActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AGoombanicsBreakableActor, bIsBroken);
 }
 
 void AGoombanicsBreakableActor::BeginPlay()
 {
 	Super::BeginPlay();
+
+	IntactMesh = MeshComponent->GetStaticMesh();
+
+	if (GetNetMode() != NM_Client && GetNetMode() != NM_Standalone && ShouldReplicateIndividually())
+	{
+		// Placed props already exist on clients, so they need no initial bunch at all.
+		// Spawned props send one, then go dormant until Break flushes them.
+		if (CVarBreakablesUseDormancy.GetValueOnGameThread())
+		{
+			NetDormancy = IsNetStartupActor() ? DORM_Initial : DORM_DormantAll;
+		}
+		if (!IsNetStartupActor())
+		{
+			SetReplicates(true);
+		}
+	}
+
+	if (DestructionIndex == INDEX_NONE)
+	{
+		if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+		{
+			Destruction->RegisterUnindexedBreakable(this);
+		}
+	}
+}
+
+void AGoombanicsBreakableActor::PostLoad()
+{
+	Super::PostLoad();
+
+	// Runs on server and clients before the level's actors are initialized for
+	// network, so a placed prop's channel (and its roles) match on both sides.
+	bReplicates = bReplicateIndividually || CVarBreakablesReplicateIndividually.GetValueOnAnyThread();
+}
+
+void AGoombanicsBreakableActor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	bReplicates = bReplicateIndividually;
+
+	// Keep the modifier's footprint in step with the authored box and actor scale.
+	NavModifier->FailsafeExtent = CollisionComponent->GetScaledBoxExtent();
+	NavModifier->SetAreaClass(IntactNavArea);
+}
+
+bool AGoombanicsBreakableActor::ShouldReplicateIndividually() const
+{
+	return bReplicateIndividually
+		|| DestructionIndex == INDEX_NONE
+		|| CVarBreakablesReplicateIndividually.GetValueOnGameThread();
 }
 
 void AGoombanicsBreakableActor::Break(APlayerState* Instigator)
 {
-	if (bIsBroken)
+	// Clients only break props through ApplyReplicatedBreak.
+	if (bIsBroken || GetNetMode() == NM_Client)
 	{
 		return;
 	}
 
+	// Wake for exactly one update carrying bIsBroken; dormancy is kept, so the
+	// channel closes again once it has been sent.
+	if (GetIsReplicated() && NetDormancy > DORM_Awake)
+	{
+		FlushNetDormancy();
+	}
+
 	bIsBroken = true;
 	OnBroken(Instigator);
+
+	if (BrokenNavArea != IntactNavArea)
+	{
+		if (UGoombanicsDestructionNavSubsystem* DestructionNav = UGoombanicsDestructionNavSubsystem::Get(this))
+		{
+			DestructionNav->QueueAreaChange(NavModifier, BrokenNavArea ? BrokenNavArea : TSubclassOf<UNavArea>(UNavArea_Default::StaticClass()));
+		}
+	}
+
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		Destruction->NotifyBroken(DestructionIndex);
+	}
+
+	OnBrokenNative.Broadcast(this, Instigator);
+}
+
+void AGoombanicsBreakableActor::ApplyReplicatedBreak()
+{
+	if (bIsBroken)
+	{
+		return;
+	}
+
+	bIsBroken = true;
+	QueueBrokenPresentation(nullptr);
+}
+
+bool AGoombanicsBreakableActor::ApplyPredictedBreak()
+{
+	if (bIsBroken || bPredictedBroken)
+	{
+		return false;
+	}
+
+	bPredictedBroken = true;
+	if (BrokenMesh)
+	{
+		PredictedIntactMesh = MeshComponent->GetStaticMesh();
+		MeshComponent->SetStaticMesh(BrokenMesh);
+	}
+	else
+	{
+		SetActorHiddenInGame(true);
+	}
+	return true;
+}
+
+void AGoombanicsBreakableActor::RollbackPredictedBreak()
+{
+	if (!bPredictedBroken || bIsBroken)
+	{
+		return;
+	}
+
+	bPredictedBroken = false;
+	if (PredictedIntactMesh)
+	{
+		MeshComponent->SetStaticMesh(PredictedIntactMesh);
+		PredictedIntactMesh = nullptr;
+	}
+	else
+	{
+		SetActorHiddenInGame(false);
+	}
+}
+
+void AGoombanicsBreakableActor::ResetBroken()
+{
+	if (!bIsBroken && !bPredictedBroken)
+	{
+		return;
+	}
+
+	if (GetNetMode() != NM_Client)
+	{
+		// One more update carrying bIsBroken = false, then dormant again.
+		if (GetIsReplicated() && NetDormancy > DORM_Awake)
+		{
+			FlushNetDormancy();
+		}
+
+		if (bIsBroken && BrokenNavArea != IntactNavArea)
+		{
+			if (UGoombanicsDestructionNavSubsystem* DestructionNav = UGoombanicsDestructionNavSubsystem::Get(this))
+			{
+				DestructionNav->QueueAreaChange(NavModifier, IntactNavArea);
+			}
+		}
+	}
+
+	bIsBroken = false;
+	ApplyIntactVisuals();
+}
+
+void AGoombanicsBreakableActor::OnRep_IsBroken()
+{
+	// The bitset may have applied this break (or reset) first, in which case
+	// bIsBroken already matched locally and this does not fire.
+	if (bIsBroken)
+	{
+		QueueBrokenPresentation(nullptr);
+	}
+	else
+	{
+		ApplyIntactVisuals();
+	}
 }
 
 void AGoombanicsBreakableActor::OnBroken(APlayerState* Instigator)
@@ -49,7 +256,39 @@ void AGoombanicsBreakableActor::OnBroken(APlayerState* Instigator)
 		}
 	}
 
+	QueueBrokenPresentation(Instigator);
+
+	UE_LOG(LogGoombanics, Verbose, TEXT("Breakable destroyed: %s, value: %.1f"), *GetName(), DestructionValue);
+}
+
+void AGoombanicsBreakableActor::QueueBrokenPresentation(APlayerState* Instigator)
+{
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		Destruction->QueueBrokenPresentation(this, INDEX_NONE, GetActorLocation(), Instigator);
+	}
+	else
+	{
+		ApplyBrokenPresentation(Instigator);
+	}
+}
+
+void AGoombanicsBreakableActor::ApplyBrokenPresentation(APlayerState* Instigator)
+{
+	// Reset by a round restart while still queued.
+	if (!bIsBroken)
+	{
+		return;
+	}
+
 	OnBreakableDestroyed.Broadcast(this, Instigator);
+	ApplyBrokenVisuals();
+}
+
+void AGoombanicsBreakableActor::ApplyBrokenVisuals()
+{
+	bPredictedBroken = false;
+	PredictedIntactMesh = nullptr;
 
 	if (BrokenMesh)
 	{
@@ -60,6 +299,17 @@ void AGoombanicsBreakableActor::OnBroken(APlayerState* Instigator)
 		SetActorHiddenInGame(true);
 		SetActorEnableCollision(false);
 	}
+}
 
-	UE_LOG(LogGoombanics, Verbose, TEXT("Breakable destroyed: %s, value: %.1f"), *GetName(), DestructionValue);
+void AGoombanicsBreakableActor::ApplyIntactVisuals()
+{
+	bPredictedBroken = false;
+	PredictedIntactMesh = nullptr;
+
+	if (IntactMesh)
+	{
+		MeshComponent->SetStaticMesh(IntactMesh);
+	}
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
 }
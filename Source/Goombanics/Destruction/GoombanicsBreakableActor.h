@@ -8,9 +8,29 @@
 
 class UStaticMeshComponent;
 class UBoxComponent;
+class UNavModifierComponent;
+class UNavArea;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBreakableDestroyed, AGoombanicsBreakableActor*, Breakable, APlayerState*, Destroyer);
 
+// Server, fired inside Break() (before queued presentation); for gameplay systems such as structures.
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBreakableBrokenNative, AGoombanicsBreakableActor* /*Breakable*/, APlayerState* /*Destroyer*/);
+
+// -----------------------------------------------------------------------------
+// AGoombanicsBreakableActor
+//
+// Level-placed breakables replicate their broken state through the destruction
+// manager's bitset and have no channel of their own.
+//
+// Props that need a channel (bReplicateIndividually, or spawned at runtime and so
+// without a stable index) replicate bIsBroken themselves. They start dormant and
+// are flushed once on Break, so an untouched prop costs the server nothing per
+// net update. goombanics.Breakables.UseDormancy=0 keeps them awake (profiling).
+//
+// Navigation: collision and mesh never touch the navmesh. NavModifier marks the
+// footprint with IntactNavArea; a server break hands BrokenNavArea to
+// UGoombanicsDestructionNavSubsystem, which batches the change per navmesh tile.
+// -----------------------------------------------------------------------------
 UCLASS()
 class GOOMBANICS_API AGoombanicsBreakableActor : public AActor
 {
@@ -19,7 +39,10 @@ class GOOMBANICS_API AGoombanicsBreakableActor : public AActor
 public:
 	AGoombanicsBreakableActor();
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void BeginPlay() override;
+	virtual void PostLoad() override;
+	virtual void OnConstruction(const FTransform& Transform) override;
 
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Destruction")
 	void Break(APlayerState* Instigator);
@@ -30,11 +53,50 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
 	float GetDestructionValue() const { return DestructionValue; }
 
+	bool ContributesToDestructionMeter() const { return bContributesToDestructionMeter; }
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
+	int32 GetDistrictId() const { return DistrictId; }
+
+	// Stable index into the replicated destruction bitset (see UGoombanicsDestructionSubsystem).
+	int32 GetDestructionIndex() const { return DestructionIndex; }
+	void SetDestructionIndex(int32 InIndex) { DestructionIndex = InIndex; }
+
+	// Client: the server broke this prop. Visuals and events only, no scoring.
+	void ApplyReplicatedBreak();
+
+	// Client: the local player's shot broke this prop; show it before the server
+	// confirms. Visuals only: collision stays until the break is confirmed.
+	bool ApplyPredictedBreak();
+
+	// Client: the server never confirmed the predicted break; restore the prop.
+	void RollbackPredictedBreak();
+
+	// Round reset: restore the intact prop in place (mesh, visibility, collision,
+	// nav area on the server). No respawn; the actor and its index are kept.
+	void ResetBroken();
+
+	// Broadcast and visual/physics swap for a break; run by the destruction queue.
+	void ApplyBrokenPresentation(APlayerState* Instigator);
+
 	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Destruction|Events")
 	FOnBreakableDestroyed OnBreakableDestroyed;
 
+	FOnBreakableBrokenNative OnBrokenNative;
+
 protected:
 	virtual void OnBroken(APlayerState* Instigator);
+	virtual void ApplyBrokenVisuals();
+	virtual void ApplyIntactVisuals();
+
+	// Hands ApplyBrokenPresentation to the frame-budgeted destruction queue.
+	void QueueBrokenPresentation(APlayerState* Instigator);
+
+	// Server: true if this prop needs its own channel rather than a bitset slot.
+	bool ShouldReplicateIndividually() const;
+
+	UFUNCTION()
+	void OnRep_IsBroken();
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Goombanics|Components")
 	TObjectPtr<UStaticMeshComponent> MeshComponent;
@@ -42,6 +104,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Goombanics|Components")
 	TObjectPtr<UBoxComponent> CollisionComponent;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Goombanics|Components")
+	TObjectPtr<UNavModifierComponent> NavModifier;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Destruction")
 	float DestructionValue = 100.0f;
 
@@ -51,6 +116,35 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Destruction")
 	TObjectPtr<UStaticMesh> BrokenMesh;
 
-	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Destruction")
+	// City district this prop belongs to (baked into the breakable manifest).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Destruction", meta = (ClampMin = "0", ClampMax = "65535"))
+	int32 DistrictId = 0;
+
+	// Nav area over the prop's footprint while intact (Null cuts the navmesh).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Destruction|Navigation")
+	TSubclassOf<UNavArea> IntactNavArea;
+
+	// Nav area once broken; unset means plain walkable. Props that leave blocking
+	// rubble (BrokenMesh with collision) should keep IntactNavArea or use an obstacle area.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Destruction|Navigation")
+	TSubclassOf<UNavArea> BrokenNavArea;
+
+	// Hero props whose Blueprint logic needs an actor channel. Replicated dormant.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Destruction|Network")
+	bool bReplicateIndividually = false;
+
+	UPROPERTY(ReplicatedUsing = OnRep_IsBroken, BlueprintReadOnly, Category = "Goombanics|Destruction")
 	bool bIsBroken = false;
+
+	int32 DestructionIndex = INDEX_NONE;
+
+	// Authored mesh, restored on a round reset when BrokenMesh swapped it out.
+	UPROPERTY(Transient)
+	TObjectPtr<UStaticMesh> IntactMesh;
+
+	// Client: mesh to restore if a predicted break is rolled back.
+	UPROPERTY(Transient)
+	TObjectPtr<UStaticMesh> PredictedIntactMesh;
+
+	bool bPredictedBroken = false;
 };
@@ -0,0 +1,296 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsBreakableField.h"
+#include "GoombanicsDestructionSubsystem.h"
+#include "Goombanics/Core/GoombanicsGameState.h"
+#include "Goombanics/Goombanics.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/HitResult.h"
+#include "Kismet/GameplayStatics.h"
+
+AGoombanicsBreakableField::AGoombanicsBreakableField()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	IntactInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("IntactInstances"));
+	IntactInstances->SetCollisionProfileName(TEXT("BlockAll"));
+	RootComponent = IntactInstances;
+
+	BrokenInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("BrokenInstances"));
+	BrokenInstances->SetupAttachment(RootComponent);
+	BrokenInstances->SetCollisionProfileName(TEXT("BlockAll"));
+
+	// Broken state replicates through the destruction manager's bitset.
+	bReplicates = false;
+}
+
+void AGoombanicsBreakableField::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (BrokenMesh)
+	{
+		BrokenInstances->SetStaticMesh(BrokenMesh);
+	}
+
+	// Instances authored before the hidden flag existed have no custom data yet.
+	if (IntactInstances->NumCustomDataFloats <= PredictedHiddenCustomDataIndex)
+	{
+		IntactInstances->SetNumCustomDataFloats(PredictedHiddenCustomDataIndex + 1);
+	}
+
+	EnsureInstanceState();
+}
+
+int32 AGoombanicsBreakableField::GetInstanceCount() const
+{
+	return IntactInstances->GetInstanceCount();
+}
+
+float AGoombanicsBreakableField::GetAuthoredInstanceValue(int32 InstanceIndex) const
+{
+	const float Override = InstanceValueOverrides.IsValidIndex(InstanceIndex) ? InstanceValueOverrides[InstanceIndex] : 0.0f;
+	return Override > 0.0f ? Override : DestructionValue;
+}
+
+FVector AGoombanicsBreakableField::GetAuthoredInstanceLocation(int32 InstanceIndex) const
+{
+	FTransform InstanceTransform;
+	IntactInstances->GetInstanceTransform(InstanceIndex, InstanceTransform, true);
+	return InstanceTransform.GetLocation();
+}
+
+void AGoombanicsBreakableField::EnsureInstanceState()
+{
+	// Replicated breaks can arrive before BeginPlay on clients.
+	if (InstanceValues.Num() != GetInstanceCount())
+	{
+		InitializeInstanceState();
+	}
+}
+
+void AGoombanicsBreakableField::InitializeInstanceState()
+{
+	const int32 NumInstances = IntactInstances->GetInstanceCount();
+
+	InstanceValues.SetNumUninitialized(NumInstances);
+	for (int32 Index = 0; Index < NumInstances; ++Index)
+	{
+		InstanceValues[Index] = GetAuthoredInstanceValue(Index);
+	}
+
+	BrokenBits.Init(false, NumInstances);
+	MeterBits.Init(bContributesToDestructionMeter, NumInstances);
+	NumBroken = 0;
+}
+
+int32 AGoombanicsBreakableField::GetInstanceIndexForHit(const FHitResult& Hit) const
+{
+	return Hit.GetComponent() == IntactInstances ? Hit.Item : INDEX_NONE;
+}
+
+bool AGoombanicsBreakableField::BreakInstanceForHit(const FHitResult& Hit, APlayerState* Instigator)
+{
+	const int32 InstanceIndex = GetInstanceIndexForHit(Hit);
+	return InstanceIndex != INDEX_NONE && BreakInstance(InstanceIndex, Instigator);
+}
+
+bool AGoombanicsBreakableField::BreakInstance(int32 InstanceIndex, APlayerState* Instigator)
+{
+	// Clients only break instances through ApplyReplicatedInstanceBreak.
+	if (GetNetMode() == NM_Client)
+	{
+		return false;
+	}
+
+	EnsureInstanceState();
+	if (!InstanceValues.IsValidIndex(InstanceIndex) || BrokenBits[InstanceIndex])
+	{
+		return false;
+	}
+
+	BrokenBits[InstanceIndex] = true;
+	++NumBroken;
+	OnInstanceBroken(InstanceIndex, Instigator);
+
+	if (DestructionIndexBase != INDEX_NONE)
+	{
+		if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+		{
+			Destruction->NotifyBroken(DestructionIndexBase + InstanceIndex);
+		}
+	}
+	return true;
+}
+
+void AGoombanicsBreakableField::ApplyReplicatedInstanceBreak(int32 InstanceIndex)
+{
+	EnsureInstanceState();
+	if (!InstanceValues.IsValidIndex(InstanceIndex) || BrokenBits[InstanceIndex])
+	{
+		return;
+	}
+
+	BrokenBits[InstanceIndex] = true;
+	++NumBroken;
+	QueueInstanceBrokenPresentation(InstanceIndex, nullptr);
+}
+
+int32 AGoombanicsBreakableField::BreakInstancesInRadius(const FVector& Center, float Radius, APlayerState* Instigator)
+{
+	const TArray<int32> Overlapping = IntactInstances->GetInstancesOverlappingSphere(Center, Radius, true);
+
+	int32 NumBrokenNow = 0;
+	for (int32 InstanceIndex : Overlapping)
+	{
+		if (BreakInstance(InstanceIndex, Instigator))
+		{
+			++NumBrokenNow;
+		}
+	}
+
+	return NumBrokenNow;
+}
+
+bool AGoombanicsBreakableField::IsInstanceBroken(int32 InstanceIndex) const
+{
+	return BrokenBits.IsValidIndex(InstanceIndex) && BrokenBits[InstanceIndex];
+}
+
+float AGoombanicsBreakableField::GetInstanceValue(int32 InstanceIndex) const
+{
+	return InstanceValues.IsValidIndex(InstanceIndex) ? InstanceValues[InstanceIndex] : 0.0f;
+}
+
+float AGoombanicsBreakableField::GetTotalMeterValue() const
+{
+	float Total = 0.0f;
+	for (TConstSetBitIterator<> It(MeterBits); It; ++It)
+	{
+		Total += InstanceValues[It.GetIndex()];
+	}
+	return Total;
+}
+
+void AGoombanicsBreakableField::OnInstanceBroken(int32 InstanceIndex, APlayerState* Instigator)
+{
+	const float Value = InstanceValues[InstanceIndex];
+
+	if (MeterBits[InstanceIndex])
+	{
+		if (AGoombanicsGameState* GS = Cast<AGoombanicsGameState>(UGameplayStatics::GetGameState(GetWorld())))
+		{
+			GS->AddDestructionValue(Value, Instigator);
+		}
+	}
+
+	QueueInstanceBrokenPresentation(InstanceIndex, Instigator);
+
+	UE_LOG(LogGoombanics, Verbose, TEXT("Breakable instance destroyed: %s[%d], value: %.1f"), *GetName(), InstanceIndex, Value);
+}
+
+void AGoombanicsBreakableField::QueueInstanceBrokenPresentation(int32 InstanceIndex, APlayerState* Instigator)
+{
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		Destruction->QueueBrokenPresentation(this, InstanceIndex, GetAuthoredInstanceLocation(InstanceIndex), Instigator);
+	}
+	else
+	{
+		ApplyInstanceBrokenPresentation(InstanceIndex, Instigator);
+	}
+}
+
+void AGoombanicsBreakableField::ApplyInstanceBrokenPresentation(int32 InstanceIndex, APlayerState* Instigator)
+{
+	// Reset by a round restart while still queued.
+	if (!IsInstanceBroken(InstanceIndex))
+	{
+		return;
+	}
+
+	OnInstanceDestroyed.Broadcast(this, InstanceIndex, Instigator);
+	ApplyInstanceBrokenVisuals(InstanceIndex);
+}
+
+bool AGoombanicsBreakableField::ApplyPredictedInstanceBreak(int32 InstanceIndex)
+{
+	EnsureInstanceState();
+
+	if (!InstanceValues.IsValidIndex(InstanceIndex) || BrokenBits[InstanceIndex] || PredictedInstances.Contains(InstanceIndex))
+	{
+		return false;
+	}
+
+	// Hidden only, never zero-scaled: a mispredicted break must still block movement
+	// and shots. The broken instance is added when the server confirms, so a
+	// rollback never has to remove one (which would shift instance indices).
+	PredictedInstances.Add(InstanceIndex);
+	SetInstanceHiddenByPrediction(InstanceIndex, true);
+	return true;
+}
+
+void AGoombanicsBreakableField::RollbackPredictedInstanceBreak(int32 InstanceIndex)
+{
+	if (BrokenBits.IsValidIndex(InstanceIndex) && !BrokenBits[InstanceIndex] && PredictedInstances.Remove(InstanceIndex) > 0)
+	{
+		SetInstanceHiddenByPrediction(InstanceIndex, false);
+	}
+}
+
+void AGoombanicsBreakableField::SetInstanceHiddenByPrediction(int32 InstanceIndex, bool bHidden)
+{
+	IntactInstances->SetCustomDataValue(InstanceIndex, PredictedHiddenCustomDataIndex, bHidden ? 1.0f : 0.0f, true);
+}
+
+void AGoombanicsBreakableField::ApplyInstanceBrokenVisuals(int32 InstanceIndex)
+{
+	// The zero scale below takes over from a predicted hide, and the flag is cleared
+	// so a round reset only has to restore the scale.
+	if (PredictedInstances.Remove(InstanceIndex) > 0)
+	{
+		SetInstanceHiddenByPrediction(InstanceIndex, false);
+	}
+
+	FTransform InstanceTransform;
+	IntactInstances->GetInstanceTransform(InstanceIndex, InstanceTransform, false);
+
+	if (BrokenMesh)
+	{
+		BrokenInstances->AddInstance(InstanceTransform, false);
+	}
+
+	BrokenInstanceScales.Add(InstanceIndex, InstanceTransform.GetScale3D());
+
+	// Zero scale hides the instance and drops its physics body while keeping indices stable.
+	InstanceTransform.SetScale3D(FVector::ZeroVector);
+	IntactInstances->UpdateInstanceTransform(InstanceIndex, InstanceTransform, false, true, true);
+}
+
+void AGoombanicsBreakableField::ResetBrokenInstances()
+{
+	EnsureInstanceState();
+
+	for (const int32 Predicted : PredictedInstances)
+	{
+		IntactInstances->SetCustomDataValue(Predicted, PredictedHiddenCustomDataIndex, 0.0f, false);
+	}
+	PredictedInstances.Reset();
+
+	// Location and rotation survive the zero scale; only the scale needs restoring.
+	for (const TPair<int32, FVector>& Broken : BrokenInstanceScales)
+	{
+		FTransform InstanceTransform;
+		IntactInstances->GetInstanceTransform(Broken.Key, InstanceTransform, false);
+		InstanceTransform.SetScale3D(Broken.Value);
+		IntactInstances->UpdateInstanceTransform(Broken.Key, InstanceTransform, false, false, true);
+	}
+	BrokenInstanceScales.Reset();
+
+	IntactInstances->MarkRenderStateDirty();
+	BrokenInstances->ClearInstances();
+
+	BrokenBits.Init(false, InstanceValues.Num());
+	NumBroken = 0;
+}
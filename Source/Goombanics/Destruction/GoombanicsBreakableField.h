@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GoombanicsBreakableField.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+struct FHitResult;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnBreakableInstanceDestroyed, AGoombanicsBreakableField*, Field, int32, InstanceIndex, APlayerState*, Destroyer);
+
+// -----------------------------------------------------------------------------
+// AGoombanicsBreakableField
+//
+// Many props of one mesh type held as instanced static mesh instances, for dense
+// city blocks where one actor per prop costs too much (memory, actor iteration,
+// relevancy, draw calls). AGoombanicsBreakableActor stays for hero props.
+//
+// Authoring: place instances on IntactInstances; optionally override per-instance
+// values in InstanceValueOverrides (index-aligned, <= 0 uses DestructionValue).
+//
+// Runtime state is packed per instance (value, broken bit, meter bit) and indexed
+// by the intact ISM instance index, which never changes: broken instances are
+// zero-scaled (hidden, no collision) rather than removed, and optionally replaced
+// by an instance of BrokenMesh on BrokenInstances.
+//
+// Predicted breaks only hide the instance, by setting per-instance custom data
+// float PredictedHiddenCustomDataIndex to 1; the intact mesh's material must mask
+// or collapse instances on it. Collision stays until the server confirms.
+//
+// Not replicated: the destruction manager's bitset carries each instance's bit.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API AGoombanicsBreakableField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AGoombanicsBreakableField();
+
+	virtual void BeginPlay() override;
+
+	// InstanceIndex is the intact ISM instance (see GetInstanceIndexForHit for traces).
+	UFUNCTION(BlueprintCallable, Category = "Goombanics|Destruction")
+	bool BreakInstance(int32 InstanceIndex, APlayerState* Instigator);
+
+	// Intact instance a trace hit, or INDEX_NONE. Hits on rubble (BrokenInstances)
+	// carry an Item from the other ISM and must not map to an intact instance.
+	int32 GetInstanceIndexForHit(const FHitResult& Hit) const;
+
+	// BreakInstance for the intact instance a trace hit; false for rubble hits.
+	bool BreakInstanceForHit(const FHitResult& Hit, APlayerState* Instigator);
+
+	// Breaks every intact instance whose origin lies within Radius. Returns the number broken.
+	UFUNCTION(BlueprintCallable, Category = "Goombanics|Destruction")
+	int32 BreakInstancesInRadius(const FVector& Center, float Radius, APlayerState* Instigator);
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
+	bool IsInstanceBroken(int32 InstanceIndex) const;
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
+	float GetInstanceValue(int32 InstanceIndex) const;
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
+	int32 GetNumInstances() const { return InstanceValues.Num(); }
+
+	// Authored instance count; valid before BeginPlay (used for stable index ranges).
+	int32 GetInstanceCount() const;
+
+	// Authored value of an instance (override or DestructionValue); valid before BeginPlay.
+	float GetAuthoredInstanceValue(int32 InstanceIndex) const;
+
+	// Authored instance origin in world space; valid before BeginPlay.
+	FVector GetAuthoredInstanceLocation(int32 InstanceIndex) const;
+
+	bool ContributesToDestructionMeter() const { return bContributesToDestructionMeter; }
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
+	int32 GetDistrictId() const { return DistrictId; }
+
+	// Instance i owns stable destruction index DestructionIndexBase + i.
+	int32 GetDestructionIndexBase() const { return DestructionIndexBase; }
+	void SetDestructionIndexBase(int32 InIndex) { DestructionIndexBase = InIndex; }
+
+	// Client: the server broke this instance. Visuals and events only, no scoring.
+	void ApplyReplicatedInstanceBreak(int32 InstanceIndex);
+
+	// Client: hide an instance the local player's shot broke, ahead of the server.
+	// Visual only; the instance keeps its collision until the break is confirmed.
+	bool ApplyPredictedInstanceBreak(int32 InstanceIndex);
+
+	// Client: the server never confirmed the predicted break; restore the instance.
+	void RollbackPredictedInstanceBreak(int32 InstanceIndex);
+
+	// Round reset: restore every broken (or predicted) instance in place and drop
+	// the broken mesh instances. Indices are unchanged.
+	void ResetBrokenInstances();
+
+	// Broadcast and instance swap for a break; run by the destruction queue.
+	void ApplyInstanceBrokenPresentation(int32 InstanceIndex, APlayerState* Instigator);
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
+	int32 GetNumBrokenInstances() const { return NumBroken; }
+
+	// Sum of values of instances that feed the destruction meter.
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction")
+	float GetTotalMeterValue() const;
+
+	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Destruction|Events")
+	FOnBreakableInstanceDestroyed OnInstanceDestroyed;
+
+	// Per-instance custom data float the intact material reads as "hidden" (0 or 1).
+	static constexpr int32 PredictedHiddenCustomDataIndex = 0;
+
+protected:
+	void InitializeInstanceState();
+	void EnsureInstanceState();
+	void SetInstanceHiddenByPrediction(int32 InstanceIndex, bool bHidden);
+	virtual void OnInstanceBroken(int32 InstanceIndex, APlayerState* Instigator);
+	virtual void ApplyInstanceBrokenVisuals(int32 InstanceIndex);
+
+	// Hands ApplyInstanceBrokenPresentation to the frame-budgeted destruction queue.
+	void QueueInstanceBrokenPresentation(int32 InstanceIndex, APlayerState* Instigator);
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Goombanics|Components")
+	TObjectPtr<UInstancedStaticMeshComponent> IntactInstances;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Goombanics|Components")
+	TObjectPtr<UInstancedStaticMeshComponent> BrokenInstances;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Destruction")
+	float DestructionValue = 25.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Destruction")
+	TArray<float> InstanceValueOverrides;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Destruction")
+	bool bContributesToDestructionMeter = true;
+
+	// Optional replacement mesh; if unset, broken instances are just hidden.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Destruction")
+	TObjectPtr<UStaticMesh> BrokenMesh;
+
+	// City district every instance belongs to (baked into the breakable manifest).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Destruction", meta = (ClampMin = "0", ClampMax = "65535"))
+	int32 DistrictId = 0;
+
+	// Packed per-instance state, indexed by intact instance index.
+	TArray<float> InstanceValues;
+	TBitArray<> BrokenBits;
+	TBitArray<> MeterBits;
+	int32 NumBroken = 0;
+	int32 DestructionIndexBase = INDEX_NONE;
+
+	// Client: instances hidden by a predicted break (custom data only, still collidable).
+	TSet<int32> PredictedInstances;
+
+	// Authored scale of each broken instance (zero-scaled while broken), for a round reset.
+	TMap<int32, FVector> BrokenInstanceScales;
+};
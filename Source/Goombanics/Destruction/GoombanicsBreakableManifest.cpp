@@ -0,0 +1,155 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsBreakableManifest.h"
+#include "GoombanicsBreakableActor.h"
+#include "GoombanicsBreakableField.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/World.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+void FGoombanicsBreakableManifest::Reset()
+{
+	Positions.Reset();
+	Values.Reset();
+	DistrictIds.Reset();
+	MeterBits.Reset();
+	OwnerSlotCounts.Reset();
+	TotalMeterValue = 0.0;
+	ContentHash = 0;
+}
+
+void FGoombanicsBreakableManifest::AddEntry(const FVector& Position, float Value, bool bContributesToMeter, int32 DistrictId)
+{
+	Positions.Add(FVector3f(Position));
+	Values.Add(Value);
+	DistrictIds.Add(static_cast<uint16>(FMath::Clamp(DistrictId, 0, static_cast<int32>(MAX_uint16))));
+	MeterBits.Add(bContributesToMeter);
+
+	if (bContributesToMeter)
+	{
+		TotalMeterValue += Value;
+	}
+}
+
+void FGoombanicsBreakableManifest::AddBreakables(const TArray<AActor*>& Ordered)
+{
+	for (const AActor* Actor : Ordered)
+	{
+		if (const AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Actor))
+		{
+			const int32 Count = Field->GetInstanceCount();
+			OwnerSlotCounts.Add(Count);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				AddEntry(Field->GetAuthoredInstanceLocation(Index), Field->GetAuthoredInstanceValue(Index), Field->ContributesToDestructionMeter(), Field->GetDistrictId());
+			}
+		}
+		else if (const AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(Actor))
+		{
+			OwnerSlotCounts.Add(1);
+			AddEntry(Breakable->GetActorLocation(), Breakable->GetDestructionValue(), Breakable->ContributesToDestructionMeter(), Breakable->GetDistrictId());
+		}
+	}
+
+	ContentHash = ComputeContentHash();
+}
+
+uint32 FGoombanicsBreakableManifest::ComputeContentHash() const
+{
+	uint32 Hash = FCrc::MemCrc32(Positions.GetData(), Positions.Num() * Positions.GetTypeSize());
+	Hash = FCrc::MemCrc32(Values.GetData(), Values.Num() * Values.GetTypeSize(), Hash);
+	Hash = FCrc::MemCrc32(DistrictIds.GetData(), DistrictIds.Num() * DistrictIds.GetTypeSize(), Hash);
+	Hash = FCrc::MemCrc32(OwnerSlotCounts.GetData(), OwnerSlotCounts.Num() * OwnerSlotCounts.GetTypeSize(), Hash);
+
+	// Meter bits one word at a time; the bit array's padding is not part of the content.
+	uint32 Word = 0;
+	for (int32 Index = 0; Index < MeterBits.Num(); ++Index)
+	{
+		Word |= (MeterBits[Index] ? 1u : 0u) << (Index & 31);
+		if ((Index & 31) == 31 || Index == MeterBits.Num() - 1)
+		{
+			Hash = FCrc::MemCrc32(&Word, sizeof(Word), Hash);
+			Word = 0;
+		}
+	}
+
+	return Hash;
+}
+
+bool FGoombanicsBreakableManifest::Serialize(FArchive& Ar)
+{
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	Ar << Magic;
+	Ar << Version;
+
+	if (Ar.IsLoading() && (Magic != FileMagic || Version != FileVersion))
+	{
+		Reset();
+		return false;
+	}
+
+	Ar << ContentHash;
+	Ar << TotalMeterValue;
+	Positions.BulkSerialize(Ar);
+	Values.BulkSerialize(Ar);
+	DistrictIds.BulkSerialize(Ar);
+	OwnerSlotCounts.BulkSerialize(Ar);
+	Ar << MeterBits;
+
+	if (Ar.IsLoading())
+	{
+		const int32 Count = Values.Num();
+		if (Ar.IsError() || Positions.Num() != Count || DistrictIds.Num() != Count || MeterBits.Num() != Count)
+		{
+			Reset();
+			return false;
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+bool FGoombanicsBreakableManifest::SaveToFile(const FString& Filename)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Serialize(Writer);
+	return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FGoombanicsBreakableManifest::LoadFromFile(const FString& Filename)
+{
+	Reset();
+
+	// One read of the whole file; the arrays then bulk-copy out of memory.
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	if (!Serialize(Reader))
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("BreakableManifest: %s is corrupt or from another version; rebake it"), *Filename);
+		return false;
+	}
+	return true;
+}
+
+FString FGoombanicsBreakableManifest::GetFilenameForMap(const FString& MapPackageName)
+{
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(MapPackageName));
+	return FPaths::ProjectContentDir() / TEXT("Data/Manifests") / (MapName + TEXT(".gbm"));
+}
+
+FString FGoombanicsBreakableManifest::GetFilenameForWorld(const UWorld* World)
+{
+	return World ? GetFilenameForMap(World->GetOutermost()->GetName()) : FString();
+}
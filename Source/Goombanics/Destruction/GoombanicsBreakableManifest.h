@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+
+// -----------------------------------------------------------------------------
+// FGoombanicsBreakableManifest
+//
+// Per-map bake of every level-placed breakable, written by
+// UGoombanicsBreakableManifestCommandlet to Content/Data/Manifests/<Map>.gbm and
+// bulk-loaded by UGoombanicsDestructionSubsystem at world begin play.
+//
+// Entries are indexed by stable destruction index (one per breakable actor, one
+// per field instance) and stored as parallel arrays so consumers can walk a
+// single attribute without touching the rest:
+// - Positions:     world origin
+// - Values:        DestructionValue (field overrides applied)
+// - MeterBits:     contributes to the destruction meter
+// - DistrictIds:   city district
+//
+// OwnerSlotCounts holds the slot count of each breakable in stable order (1 for
+// actors, instance count for fields); it lets the subsystem rebuild its index
+// table from the destruction manager's CookedBreakables without an actor scan,
+// and detect a manifest that is out of date with the level.
+//
+// ContentHash covers every entry (positions, values, districts, meter bits, slot
+// counts). The destruction manager bakes the same hash on level save, so a prop
+// moved or retuned after the manifest was written is caught at load with one
+// comparison and the subsystem rebuilds from the level instead.
+// -----------------------------------------------------------------------------
+struct GOOMBANICS_API FGoombanicsBreakableManifest
+{
+	static constexpr uint32 FileMagic = 0x4D424F47; // "GOBM"
+	static constexpr uint32 FileVersion = 2;
+
+	TArray<FVector3f> Positions;
+	TArray<float> Values;
+	TArray<uint16> DistrictIds;
+	TBitArray<> MeterBits;
+	TArray<int32> OwnerSlotCounts;
+
+	// Sum of Values over MeterBits; seeds AGoombanicsGameState::TotalDestructionValue.
+	double TotalMeterValue = 0.0;
+
+	// ComputeContentHash() at bake time.
+	uint32 ContentHash = 0;
+
+	int32 Num() const { return Values.Num(); }
+	bool IsEmpty() const { return Values.Num() == 0; }
+
+	void Reset();
+
+	// Appends one stable index entry. Call in stable index order.
+	void AddEntry(const FVector& Position, float Value, bool bContributesToMeter, int32 DistrictId);
+
+	// Appends every breakable actor / field in Ordered (stable index order) and sets ContentHash.
+	void AddBreakables(const TArray<AActor*>& Ordered);
+
+	// CRC of all entries and slot counts; independent of TotalMeterValue and ContentHash.
+	uint32 ComputeContentHash() const;
+
+	// Returns false (and leaves the manifest empty) on a bad magic, version or size.
+	bool Serialize(FArchive& Ar);
+
+	bool SaveToFile(const FString& Filename);
+	bool LoadFromFile(const FString& Filename);
+
+	// Content/Data/Manifests/<MapShortName>.gbm. PIE prefixes are stripped.
+	static FString GetFilenameForMap(const FString& MapPackageName);
+	static FString GetFilenameForWorld(const UWorld* World);
+};
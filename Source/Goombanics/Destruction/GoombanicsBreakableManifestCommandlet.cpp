@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsBreakableManifestCommandlet.h"
+#include "GoombanicsBreakableManifest.h"
+#include "GoombanicsDestructionSubsystem.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+UGoombanicsBreakableManifestCommandlet::UGoombanicsBreakableManifestCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGoombanicsBreakableManifestCommandlet::Main(const FString& Params)
+{
+	TArray<FString> MapPackageNames;
+
+	FString MapParam;
+	if (FParse::Value(*Params, TEXT("Map="), MapParam))
+	{
+		MapPackageNames.Add(MapParam);
+	}
+	else
+	{
+		TArray<FString> MapFiles;
+		IFileManager::Get().FindFilesRecursive(MapFiles, *FPaths::ProjectContentDir(), *(TEXT("*") + FPackageName::GetMapPackageExtension()), true, false);
+		for (const FString& MapFile : MapFiles)
+		{
+			FString PackageName;
+			if (FPackageName::TryConvertFilenameToLongPackageName(MapFile, PackageName))
+			{
+				MapPackageNames.Add(PackageName);
+			}
+		}
+	}
+
+	int32 NumFailed = 0;
+	for (const FString& MapPackageName : MapPackageNames)
+	{
+		if (!BakeMap(MapPackageName))
+		{
+			++NumFailed;
+		}
+	}
+
+	UE_LOG(LogGoombanics, Display, TEXT("BreakableManifest: baked %d of %d maps"), MapPackageNames.Num() - NumFailed, MapPackageNames.Num());
+	return NumFailed == 0 ? 0 : 1;
+}
+
+bool UGoombanicsBreakableManifestCommandlet::BakeMap(const FString& MapPackageName)
+{
+	UPackage* Package = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogGoombanics, Error, TEXT("BreakableManifest: could not load %s"), *MapPackageName);
+		return false;
+	}
+
+	// Components need world transforms for instance positions.
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues().AllowAudioPlayback(false).CreatePhysicsScene(false).CreateNavigation(false).CreateAISystem(false).ShouldSimulatePhysics(false));
+	}
+	World->UpdateWorldComponents(true, false);
+
+	TArray<AActor*> Ordered;
+	UGoombanicsDestructionSubsystem::BuildStableOrder(World, Ordered);
+
+	FGoombanicsBreakableManifest Manifest;
+	Manifest.AddBreakables(Ordered);
+
+	const FString Filename = FGoombanicsBreakableManifest::GetFilenameForMap(MapPackageName);
+	const bool bSaved = Manifest.SaveToFile(Filename);
+
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	if (!bSaved)
+	{
+		UE_LOG(LogGoombanics, Error, TEXT("BreakableManifest: could not write %s"), *Filename);
+		return false;
+	}
+
+	UE_LOG(LogGoombanics, Display, TEXT("BreakableManifest: %s -> %s (%d breakables, %d slots, meter total %.0f)"),
+		*MapPackageName, *Filename, Manifest.OwnerSlotCounts.Num(), Manifest.Num(), Manifest.TotalMeterValue);
+	return true;
+}
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GoombanicsBreakableManifestCommandlet.generated.h"
+
+// -----------------------------------------------------------------------------
+// UGoombanicsBreakableManifestCommandlet
+//
+// Bakes FGoombanicsBreakableManifest for each map. Run before cooking:
+//
+//   UnrealEditor-Cmd Goombanics.uproject -run=GoombanicsBreakableManifest [-Map=/Game/Maps/CityBlock_A/CityBlock_A]
+//
+// Without -Map every .umap under Content is baked. Output goes to
+// Content/Data/Manifests (staged as loose files, see DefaultGame.ini).
+//
+// Stable index order matches the runtime (UGoombanicsDestructionSubsystem::
+// BuildStableOrder), so resave maps that contain a destruction manager first.
+// Saving a map also bakes the content hash a manifest must match to be used;
+// rebake after any breakable is moved or retuned.
+// -----------------------------------------------------------------------------
+UCLASS()
+class UGoombanicsBreakableManifestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGoombanicsBreakableManifestCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	bool BakeMap(const FString& MapPackageName);
+};
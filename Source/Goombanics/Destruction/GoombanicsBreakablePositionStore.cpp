@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsBreakablePositionStore.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+namespace GoombanicsPositionStore
+{
+	// Far enough that no query matches, small enough that squaring stays finite.
+	static constexpr float RemovedCoordinate = 1.0e18f;
+
+	static FORCEINLINE void AppendLaneHits(uint32 Mask, int32 BaseIndex, TArray<int32>& OutIndices)
+	{
+		while (Mask)
+		{
+			OutIndices.Add(BaseIndex + static_cast<int32>(FMath::CountTrailingZeros(Mask)));
+			Mask &= Mask - 1;
+		}
+	}
+}
+
+void FGoombanicsBreakablePositionStore::Reset(int32 InNumEntries)
+{
+	NumEntries = FMath::Max(0, InNumEntries);
+	const int32 NumPadded = Align(NumEntries, 4);
+
+	X.Init(GoombanicsPositionStore::RemovedCoordinate, NumPadded);
+	Y.Init(GoombanicsPositionStore::RemovedCoordinate, NumPadded);
+	Z.Init(GoombanicsPositionStore::RemovedCoordinate, NumPadded);
+}
+
+void FGoombanicsBreakablePositionStore::SetPosition(int32 Index, const FVector& Position)
+{
+	if (Index >= 0 && Index < NumEntries)
+	{
+		X[Index] = static_cast<float>(Position.X);
+		Y[Index] = static_cast<float>(Position.Y);
+		Z[Index] = static_cast<float>(Position.Z);
+	}
+}
+
+void FGoombanicsBreakablePositionStore::Remove(int32 Index)
+{
+	if (Index >= 0 && Index < NumEntries)
+	{
+		X[Index] = GoombanicsPositionStore::RemovedCoordinate;
+		Y[Index] = GoombanicsPositionStore::RemovedCoordinate;
+		Z[Index] = GoombanicsPositionStore::RemovedCoordinate;
+	}
+}
+
+template <typename KernelType>
+void FGoombanicsBreakablePositionStore::RunQuery(const KernelType& Kernel, TArray<int32>& OutIndices) const
+{
+	const int32 NumPadded = X.Num();
+	if (NumPadded < ParallelQueryThreshold)
+	{
+		Kernel(0, NumPadded, OutIndices);
+		return;
+	}
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumPadded, ChunkSize);
+	TArray<TArray<int32>> ChunkHits;
+	ChunkHits.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [&Kernel, &ChunkHits, NumPadded](int32 ChunkIndex)
+	{
+		const int32 First = ChunkIndex * ChunkSize;
+		Kernel(First, FMath::Min(First + ChunkSize, NumPadded), ChunkHits[ChunkIndex]);
+	});
+
+	for (const TArray<int32>& Hits : ChunkHits)
+	{
+		OutIndices.Append(Hits);
+	}
+}
+
+void FGoombanicsBreakablePositionStore::QuerySphere(const FVector& Center, float Radius, TArray<int32>& OutIndices) const
+{
+	const float* RESTRICT PX = X.GetData();
+	const float* RESTRICT PY = Y.GetData();
+	const float* RESTRICT PZ = Z.GetData();
+
+	const VectorRegister4Float CX = VectorSetFloat1(static_cast<float>(Center.X));
+	const VectorRegister4Float CY = VectorSetFloat1(static_cast<float>(Center.Y));
+	const VectorRegister4Float CZ = VectorSetFloat1(static_cast<float>(Center.Z));
+	const VectorRegister4Float RadiusSq = VectorSetFloat1(Radius * Radius);
+
+	RunQuery([=](int32 First, int32 End, TArray<int32>& Out)
+	{
+		for (int32 Index = First; Index < End; Index += 4)
+		{
+			const VectorRegister4Float DX = VectorSubtract(VectorLoad(PX + Index), CX);
+			const VectorRegister4Float DY = VectorSubtract(VectorLoad(PY + Index), CY);
+			const VectorRegister4Float DZ = VectorSubtract(VectorLoad(PZ + Index), CZ);
+
+			VectorRegister4Float DistSq = VectorMultiply(DX, DX);
+			DistSq = VectorMultiplyAdd(DY, DY, DistSq);
+			DistSq = VectorMultiplyAdd(DZ, DZ, DistSq);
+
+			GoombanicsPositionStore::AppendLaneHits(VectorMaskBits(VectorCompareLE(DistSq, RadiusSq)), Index, Out);
+		}
+	}, OutIndices);
+}
+
+void FGoombanicsBreakablePositionStore::QueryCapsule(const FVector& SegmentStart, const FVector& SegmentEnd, float Radius, TArray<int32>& OutIndices) const
+{
+	const float* RESTRICT PX = X.GetData();
+	const float* RESTRICT PY = Y.GetData();
+	const float* RESTRICT PZ = Z.GetData();
+
+	const FVector3f Start(SegmentStart);
+	const FVector3f Axis(SegmentEnd - SegmentStart);
+	const float AxisLengthSq = Axis.SizeSquared();
+
+	const VectorRegister4Float AX = VectorSetFloat1(Start.X);
+	const VectorRegister4Float AY = VectorSetFloat1(Start.Y);
+	const VectorRegister4Float AZ = VectorSetFloat1(Start.Z);
+	const VectorRegister4Float ABX = VectorSetFloat1(Axis.X);
+	const VectorRegister4Float ABY = VectorSetFloat1(Axis.Y);
+	const VectorRegister4Float ABZ = VectorSetFloat1(Axis.Z);
+	const VectorRegister4Float InvAxisLengthSq = VectorSetFloat1(AxisLengthSq > UE_SMALL_NUMBER ? 1.0f / AxisLengthSq : 0.0f);
+	const VectorRegister4Float RadiusSq = VectorSetFloat1(Radius * Radius);
+
+	RunQuery([=](int32 First, int32 End, TArray<int32>& Out)
+	{
+		for (int32 Index = First; Index < End; Index += 4)
+		{
+			const VectorRegister4Float DX = VectorSubtract(VectorLoad(PX + Index), AX);
+			const VectorRegister4Float DY = VectorSubtract(VectorLoad(PY + Index), AY);
+			const VectorRegister4Float DZ = VectorSubtract(VectorLoad(PZ + Index), AZ);
+
+			// Closest point on the segment: t = clamp(dot(P - A, B - A) / |B - A|^2, 0, 1).
+			VectorRegister4Float T = VectorMultiply(DX, ABX);
+			T = VectorMultiplyAdd(DY, ABY, T);
+			T = VectorMultiplyAdd(DZ, ABZ, T);
+			T = VectorMin(VectorMax(VectorMultiply(T, InvAxisLengthSq), VectorZeroFloat()), VectorOneFloat());
+
+			const VectorRegister4Float OX = VectorNegateMultiplyAdd(T, ABX, DX);
+			const VectorRegister4Float OY = VectorNegateMultiplyAdd(T, ABY, DY);
+			const VectorRegister4Float OZ = VectorNegateMultiplyAdd(T, ABZ, DZ);
+
+			VectorRegister4Float DistSq = VectorMultiply(OX, OX);
+			DistSq = VectorMultiplyAdd(OY, OY, DistSq);
+			DistSq = VectorMultiplyAdd(OZ, OZ, DistSq);
+
+			GoombanicsPositionStore::AppendLaneHits(VectorMaskBits(VectorCompareLE(DistSq, RadiusSq)), Index, Out);
+		}
+	}, OutIndices);
+}
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// -----------------------------------------------------------------------------
+// FGoombanicsBreakablePositionStore
+//
+// Positions of every stable destruction index as three packed float arrays
+// (X, Y, Z), padded to a multiple of four so the query kernels test four props
+// per VectorRegister op with no scalar tail. Broken slots are moved far away
+// rather than removed, so indices never shift.
+//
+// Queries return matching stable indices in ascending order. Stores larger than
+// ParallelQueryThreshold are split into ChunkSize blocks across task graph
+// workers with ParallelFor; chunk results are concatenated in order, so output
+// is identical to the serial path.
+// -----------------------------------------------------------------------------
+struct GOOMBANICS_API FGoombanicsBreakablePositionStore
+{
+	static constexpr int32 ChunkSize = 4096;
+	static constexpr int32 ParallelQueryThreshold = 16384;
+
+	void Reset(int32 NumEntries);
+
+	int32 Num() const { return NumEntries; }
+
+	void SetPosition(int32 Index, const FVector& Position);
+
+	// Excludes Index from all future queries.
+	void Remove(int32 Index);
+
+	void QuerySphere(const FVector& Center, float Radius, TArray<int32>& OutIndices) const;
+
+	// Capsule from SegmentStart to SegmentEnd; degenerates to a sphere when they match.
+	void QueryCapsule(const FVector& SegmentStart, const FVector& SegmentEnd, float Radius, TArray<int32>& OutIndices) const;
+
+private:
+	// Runs Kernel(First, End, Out) over [0, padded count), in parallel chunks when large.
+	template <typename KernelType>
+	void RunQuery(const KernelType& Kernel, TArray<int32>& OutIndices) const;
+
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+	int32 NumEntries = 0;
+};
@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsDestructionAggregates.h"
+
+void FGoombanicsDestructionAggregates::Reset()
+{
+	SlotValue.Reset();
+	SlotDistrict.Reset();
+	SlotCell.Reset();
+	DistrictTotal.Reset();
+	DistrictBroken.Reset();
+	CellTotal.Reset();
+	CellBroken.Reset();
+	GridOrigin = FVector2D::ZeroVector;
+	CellSize = 1.0f;
+}
+
+void FGoombanicsDestructionAggregates::Init(int32 NumSlots, int32 NumDistricts, const FBox2D& Bounds)
+{
+	SlotValue.Init(0.0f, NumSlots);
+	SlotDistrict.Init(0, NumSlots);
+	SlotCell.Init(0, NumSlots);
+
+	DistrictTotal.Init(0.0f, NumDistricts);
+	DistrictBroken.Init(0.0f, NumDistricts);
+	CellTotal.Init(0.0f, GridSize * GridSize);
+	CellBroken.Init(0.0f, GridSize * GridSize);
+
+	if (Bounds.bIsValid)
+	{
+		const FVector2D Extent = Bounds.GetSize();
+		GridOrigin = Bounds.Min;
+		CellSize = FMath::Max(1.0f, static_cast<float>(FMath::Max(Extent.X, Extent.Y)) / GridSize + UE_KINDA_SMALL_NUMBER);
+	}
+	else
+	{
+		GridOrigin = FVector2D::ZeroVector;
+		CellSize = 1.0f;
+	}
+}
+
+int32 FGoombanicsDestructionAggregates::CellIndexFor(const FVector& Position) const
+{
+	const int32 CellX = FMath::Clamp(FMath::FloorToInt32((Position.X - GridOrigin.X) / CellSize), 0, GridSize - 1);
+	const int32 CellY = FMath::Clamp(FMath::FloorToInt32((Position.Y - GridOrigin.Y) / CellSize), 0, GridSize - 1);
+	return CellY * GridSize + CellX;
+}
+
+void FGoombanicsDestructionAggregates::SetSlot(int32 StableIndex, const FVector& Position, float Value, bool bContributesToMeter, int32 DistrictId)
+{
+	if (!SlotValue.IsValidIndex(StableIndex))
+	{
+		return;
+	}
+
+	const int32 District = FMath::Clamp(DistrictId, 0, DistrictTotal.Num() - 1);
+	const int32 Cell = CellIndexFor(Position);
+
+	SlotValue[StableIndex] = bContributesToMeter ? Value : 0.0f;
+	SlotDistrict[StableIndex] = static_cast<uint16>(District);
+	SlotCell[StableIndex] = static_cast<uint16>(Cell);
+
+	if (bContributesToMeter)
+	{
+		DistrictTotal[District] += Value;
+		CellTotal[Cell] += Value;
+	}
+}
+
+void FGoombanicsDestructionAggregates::OnSlotBroken(int32 StableIndex, int32& OutDistrictId, int32& OutCellIndex)
+{
+	OutDistrictId = INDEX_NONE;
+	OutCellIndex = INDEX_NONE;
+
+	if (!SlotValue.IsValidIndex(StableIndex) || SlotValue[StableIndex] <= 0.0f)
+	{
+		return;
+	}
+
+	OutDistrictId = SlotDistrict[StableIndex];
+	OutCellIndex = SlotCell[StableIndex];
+
+	DistrictBroken[OutDistrictId] += SlotValue[StableIndex];
+	CellBroken[OutCellIndex] += SlotValue[StableIndex];
+
+	// Each slot counts once.
+	SlotValue[StableIndex] = 0.0f;
+}
+
+float FGoombanicsDestructionAggregates::GetDistrictPercent(int32 DistrictId) const
+{
+	if (!DistrictTotal.IsValidIndex(DistrictId) || DistrictTotal[DistrictId] <= 0.0f)
+	{
+		return 0.0f;
+	}
+	return FMath::Min(100.0f, DistrictBroken[DistrictId] / DistrictTotal[DistrictId] * 100.0f);
+}
+
+uint8 FGoombanicsDestructionAggregates::GetQuantizedDistrict(int32 DistrictId) const
+{
+	return DistrictTotal.IsValidIndex(DistrictId) ? Quantize(DistrictBroken[DistrictId], DistrictTotal[DistrictId]) : 0;
+}
+
+uint8 FGoombanicsDestructionAggregates::GetQuantizedCell(int32 CellIndex) const
+{
+	return CellTotal.IsValidIndex(CellIndex) ? Quantize(CellBroken[CellIndex], CellTotal[CellIndex]) : 0;
+}
+
+uint8 FGoombanicsDestructionAggregates::Quantize(float Broken, float Total)
+{
+	return Total > 0.0f ? static_cast<uint8>(FMath::Clamp(FMath::RoundToInt32(Broken / Total * 255.0f), 0, 255)) : 0;
+}
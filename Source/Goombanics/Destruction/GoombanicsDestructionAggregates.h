@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GoombanicsDestructionAggregates.generated.h"
+
+// Designer data for one district; the array index is the breakables' DistrictId.
+USTRUCT(BlueprintType)
+struct FGoombanicsDistrictInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|District")
+	FText DisplayName;
+
+	// Humans lose the round once this district reaches ProtectedFailPercent.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|District")
+	bool bProtected = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|District", meta = (ClampMin = "0.0", ClampMax = "100.0", EditCondition = "bProtected"))
+	float ProtectedFailPercent = 50.0f;
+};
+
+// -----------------------------------------------------------------------------
+// FGoombanicsDestructionAggregates
+//
+// Server-side roll-up of broken value: slot -> district and slot -> heat grid
+// cell, each precomputed at index time so a break is O(1) (two adds, two
+// quantizations). Only slots that feed the destruction meter count, so district
+// percents agree with the city meter.
+//
+// Quantized values are 0..255 for 0..100%; the destruction manager replicates
+// those, never per-prop data.
+// -----------------------------------------------------------------------------
+struct GOOMBANICS_API FGoombanicsDestructionAggregates
+{
+	// Heat grid is GridSize x GridSize cells over the breakables' XY bounds.
+	static constexpr int32 GridSize = 32;
+
+	void Reset();
+
+	// Sizes everything; Bounds is the XY extent of all slots.
+	void Init(int32 NumSlots, int32 NumDistricts, const FBox2D& Bounds);
+
+	void SetSlot(int32 StableIndex, const FVector& Position, float Value, bool bContributesToMeter, int32 DistrictId);
+
+	// Adds a broken slot's value. Outputs the district and cell touched (INDEX_NONE if none).
+	void OnSlotBroken(int32 StableIndex, int32& OutDistrictId, int32& OutCellIndex);
+
+	int32 GetNumDistricts() const { return DistrictTotal.Num(); }
+	float GetDistrictPercent(int32 DistrictId) const;
+
+	uint8 GetQuantizedDistrict(int32 DistrictId) const;
+	uint8 GetQuantizedCell(int32 CellIndex) const;
+
+	FVector2D GetGridOrigin() const { return GridOrigin; }
+	float GetCellSize() const { return CellSize; }
+
+	static uint8 Quantize(float Broken, float Total);
+
+private:
+	int32 CellIndexFor(const FVector& Position) const;
+
+	TArray<float> SlotValue;
+	TArray<uint16> SlotDistrict;
+	TArray<uint16> SlotCell;
+
+	TArray<float> DistrictTotal;
+	TArray<float> DistrictBroken;
+	TArray<float> CellTotal;
+	TArray<float> CellBroken;
+
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+	float CellSize = 1.0f;
+};
@@ -0,0 +1,382 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsDestructionManager.h"
+#include "GoombanicsDestructionSubsystem.h"
+#include "GoombanicsBreakableManifest.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/Level.h"
+#include "TimerManager.h"
+#include "Net/UnrealNetwork.h"
+#include "UObject/ObjectSaveContext.h"
+
+void FGoombanicsDestructionBitset::Init(int32 InNumBits)
+{
+	NumBits = FMath::Clamp(InNumBits, 0, MaxBits);
+	Words.Init(0u, FMath::DivideAndRoundUp(NumBits, 32));
+}
+
+bool FGoombanicsDestructionBitset::Get(int32 Index) const
+{
+	if (Index < 0 || Index >= NumBits)
+	{
+		return false;
+	}
+	return (Words[Index >> 5] & (1u << (Index & 31))) != 0;
+}
+
+bool FGoombanicsDestructionBitset::Set(int32 Index, bool bValue)
+{
+	if (Index < 0 || Index >= NumBits)
+	{
+		return false;
+	}
+
+	uint32& Word = Words[Index >> 5];
+	const uint32 Mask = 1u << (Index & 31);
+	const uint32 NewWord = bValue ? (Word | Mask) : (Word & ~Mask);
+	if (NewWord == Word)
+	{
+		return false;
+	}
+
+	Word = NewWord;
+	return true;
+}
+
+int32 FGoombanicsDestructionBitset::CountSetBits() const
+{
+	int32 Count = 0;
+	for (const uint32 Word : Words)
+	{
+		Count += static_cast<int32>(FMath::CountBits(Word));
+	}
+	return Count;
+}
+
+int32 FGoombanicsDestructionBitset::FindNext(int32 StartIndex, bool bValue) const
+{
+	if (StartIndex >= NumBits)
+	{
+		return NumBits;
+	}
+
+	int32 WordIndex = StartIndex >> 5;
+	uint32 Word = bValue ? Words[WordIndex] : ~Words[WordIndex];
+	Word &= ~0u << (StartIndex & 31);
+
+	while (Word == 0)
+	{
+		if (++WordIndex >= Words.Num())
+		{
+			return NumBits;
+		}
+		Word = bValue ? Words[WordIndex] : ~Words[WordIndex];
+	}
+
+	return FMath::Min(NumBits, WordIndex * 32 + static_cast<int32>(FMath::CountTrailingZeros(Word)));
+}
+
+bool FGoombanicsDestructionBitset::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint32 PackedNumBits = static_cast<uint32>(NumBits);
+	Ar.SerializeIntPacked(PackedNumBits);
+
+	if (Ar.IsSaving())
+	{
+		// Alternating runs, starting with zeros (possibly an empty run).
+		bool bRunValue = false;
+		int32 Index = 0;
+		while (Index < NumBits)
+		{
+			const int32 RunEnd = FindNext(Index, !bRunValue);
+			uint32 RunLength = static_cast<uint32>(RunEnd - Index);
+			Ar.SerializeIntPacked(RunLength);
+			Index = RunEnd;
+			bRunValue = !bRunValue;
+		}
+		return true;
+	}
+
+	if (PackedNumBits > static_cast<uint32>(MaxBits))
+	{
+		Ar.SetError();
+		bOutSuccess = false;
+		return false;
+	}
+
+	Init(static_cast<int32>(PackedNumBits));
+
+	bool bRunValue = false;
+	int32 Index = 0;
+	while (Index < NumBits && !Ar.IsError())
+	{
+		uint32 RunLength = 0;
+		Ar.SerializeIntPacked(RunLength);
+		if (RunLength > static_cast<uint32>(NumBits - Index))
+		{
+			Ar.SetError();
+			break;
+		}
+
+		if (bRunValue)
+		{
+			for (int32 Bit = Index; Bit < Index + static_cast<int32>(RunLength); ++Bit)
+			{
+				Words[Bit >> 5] |= 1u << (Bit & 31);
+			}
+		}
+
+		Index += static_cast<int32>(RunLength);
+		bRunValue = !bRunValue;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return bOutSuccess;
+}
+
+AGoombanicsDestructionManager::AGoombanicsDestructionManager()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	NetPriority = 2.0f;
+	SetNetUpdateFrequency(10.0f);
+}
+
+void AGoombanicsDestructionManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AGoombanicsDestructionManager, BrokenBits);
+	DOREPLIFETIME(AGoombanicsDestructionManager, DistrictDestruction);
+	DOREPLIFETIME(AGoombanicsDestructionManager, HeatGrid);
+	DOREPLIFETIME(AGoombanicsDestructionManager, HeatGridOrigin);
+	DOREPLIFETIME(AGoombanicsDestructionManager, HeatGridCellSize);
+}
+
+void AGoombanicsDestructionManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		Destruction->SetManager(this);
+	}
+}
+
+#if WITH_EDITOR
+void AGoombanicsDestructionManager::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	// Bake the index order on every save (and therefore on cook) so the game never
+	// has to build and sort path names at load.
+	if (ULevel* Level = GetLevel())
+	{
+		const TArray<AActor*> LevelActors(Level->Actors);
+		TArray<AActor*> Breakables;
+		UGoombanicsDestructionSubsystem::GatherBreakables(LevelActors, Breakables);
+		CookedBreakables.Reset(Breakables.Num());
+		CookedBreakables.Append(Breakables);
+
+		FGoombanicsBreakableManifest Content;
+		Content.AddBreakables(Breakables);
+		CookedContentHash = Content.ContentHash;
+	}
+}
+#endif
+
+void AGoombanicsDestructionManager::InitializeSlots(int32 NumSlots)
+{
+	if (BrokenBits.Num() != NumSlots)
+	{
+		BrokenBits.Init(NumSlots);
+		ForceNetUpdate();
+	}
+}
+
+void AGoombanicsDestructionManager::SetBroken(int32 StableIndex, bool bBroken)
+{
+	if (BrokenBits.Set(StableIndex, bBroken))
+	{
+		ForceNetUpdate();
+	}
+}
+
+void AGoombanicsDestructionManager::ResetAll()
+{
+	BrokenBits.Init(BrokenBits.Num());
+
+	for (int32 DistrictId = 0; DistrictId < DistrictDestruction.Num(); ++DistrictId)
+	{
+		SetDistrictDestruction(DistrictId, 0);
+	}
+	for (int32 CellIndex = 0; CellIndex < HeatGrid.Num(); ++CellIndex)
+	{
+		SetHeatCell(CellIndex, 0);
+	}
+
+	ForceNetUpdate();
+}
+
+void AGoombanicsDestructionManager::OnRep_BrokenBits()
+{
+	UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this);
+	if (!Destruction)
+	{
+		return;
+	}
+
+	Destruction->EnsureIndexed();
+	if (BrokenBits.Num() != Destruction->GetNumSlots())
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("DestructionManager: server has %d slots, client indexed %d"), BrokenBits.Num(), Destruction->GetNumSlots());
+	}
+
+	// First update: diff against what the join snapshot already broke, so bits it
+	// set that are clear here (a round reset since) are restored.
+	if (!bReceivedBrokenBits)
+	{
+		bReceivedBrokenBits = true;
+		AppliedBits = Destruction->TakeJoinSnapshotBits();
+	}
+
+	// Resets first: a break that followed the reset in the same update must survive it.
+	TArray<int32> ResetIndices;
+	BrokenBits.ForEachChangedBit(AppliedBits, [&ResetIndices](int32 StableIndex, bool bBroken)
+	{
+		if (!bBroken)
+		{
+			ResetIndices.Add(StableIndex);
+		}
+	});
+
+	if (ResetIndices.Num() > 0)
+	{
+		Destruction->ApplyReplicatedReset(ResetIndices);
+	}
+
+	BrokenBits.ForEachChangedBit(AppliedBits, [Destruction](int32 StableIndex, bool bBroken)
+	{
+		if (bBroken)
+		{
+			Destruction->ApplyReplicatedBreak(StableIndex);
+		}
+	});
+
+	AppliedBits = BrokenBits;
+}
+
+void AGoombanicsDestructionManager::InitializeAggregates(int32 NumDistricts, const FVector2D& GridOrigin, float GridCellSize)
+{
+	if (DistrictDestruction.Num() == NumDistricts && HeatGridOrigin == GridOrigin && HeatGridCellSize == GridCellSize)
+	{
+		return;
+	}
+
+	DistrictDestruction.Init(0, NumDistricts);
+	HeatGrid.Init(0, FGoombanicsDestructionAggregates::GridSize * FGoombanicsDestructionAggregates::GridSize);
+	HeatGridOrigin = GridOrigin;
+	HeatGridCellSize = GridCellSize;
+	ForceNetUpdate();
+}
+
+void AGoombanicsDestructionManager::SetDistrictDestruction(int32 DistrictId, uint8 Quantized)
+{
+	if (DistrictDestruction.IsValidIndex(DistrictId) && DistrictDestruction[DistrictId] != Quantized)
+	{
+		DistrictDestruction[DistrictId] = Quantized;
+		DirtyDistricts.AddUnique(DistrictId);
+		QueueAggregateEvents();
+	}
+}
+
+void AGoombanicsDestructionManager::SetHeatCell(int32 CellIndex, uint8 Quantized)
+{
+	if (HeatGrid.IsValidIndex(CellIndex) && HeatGrid[CellIndex] != Quantized)
+	{
+		HeatGrid[CellIndex] = Quantized;
+		bHeatGridDirty = true;
+		QueueAggregateEvents();
+	}
+}
+
+void AGoombanicsDestructionManager::QueueAggregateEvents()
+{
+	// A stomp changes many cells in one frame; listeners hear about it once, next tick.
+	if (!bAggregateEventsQueued)
+	{
+		bAggregateEventsQueued = true;
+		ForceNetUpdate();
+		GetWorldTimerManager().SetTimerForNextTick(this, &AGoombanicsDestructionManager::BroadcastAggregateEvents);
+	}
+}
+
+void AGoombanicsDestructionManager::BroadcastAggregateEvents()
+{
+	bAggregateEventsQueued = false;
+
+	for (const int32 DistrictId : DirtyDistricts)
+	{
+		OnDistrictDestructionChanged.Broadcast(DistrictId, GetDistrictDestructionPercent(DistrictId));
+	}
+	DirtyDistricts.Reset();
+
+	if (bHeatGridDirty)
+	{
+		bHeatGridDirty = false;
+		OnHeatGridChanged.Broadcast();
+	}
+}
+
+float AGoombanicsDestructionManager::GetDistrictDestructionPercent(int32 DistrictId) const
+{
+	return DistrictDestruction.IsValidIndex(DistrictId) ? DistrictDestruction[DistrictId] * (100.0f / 255.0f) : 0.0f;
+}
+
+FText AGoombanicsDestructionManager::GetDistrictDisplayName(int32 DistrictId) const
+{
+	const FGoombanicsDistrictInfo* Info = FindDistrictInfo(DistrictId);
+	return Info && !Info->DisplayName.IsEmpty() ? Info->DisplayName : FText::AsNumber(DistrictId);
+}
+
+float AGoombanicsDestructionManager::GetHeatGridValue(int32 CellX, int32 CellY) const
+{
+	const int32 GridSize = FGoombanicsDestructionAggregates::GridSize;
+	if (CellX < 0 || CellY < 0 || CellX >= GridSize || CellY >= GridSize || !HeatGrid.IsValidIndex(CellY * GridSize + CellX))
+	{
+		return 0.0f;
+	}
+	return HeatGrid[CellY * GridSize + CellX] / 255.0f;
+}
+
+FIntPoint AGoombanicsDestructionManager::WorldToHeatGridCell(const FVector& WorldLocation) const
+{
+	const int32 GridSize = FGoombanicsDestructionAggregates::GridSize;
+	const float CellSize = FMath::Max(1.0f, HeatGridCellSize);
+	return FIntPoint(
+		FMath::Clamp(FMath::FloorToInt32((WorldLocation.X - HeatGridOrigin.X) / CellSize), 0, GridSize - 1),
+		FMath::Clamp(FMath::FloorToInt32((WorldLocation.Y - HeatGridOrigin.Y) / CellSize), 0, GridSize - 1));
+}
+
+void AGoombanicsDestructionManager::OnRep_DistrictDestruction()
+{
+	for (int32 DistrictId = 0; DistrictId < DistrictDestruction.Num(); ++DistrictId)
+	{
+		const uint8 Previous = AppliedDistrictDestruction.IsValidIndex(DistrictId) ? AppliedDistrictDestruction[DistrictId] : 0;
+		if (DistrictDestruction[DistrictId] != Previous)
+		{
+			OnDistrictDestructionChanged.Broadcast(DistrictId, GetDistrictDestructionPercent(DistrictId));
+		}
+	}
+
+	AppliedDistrictDestruction = DistrictDestruction;
+}
+
+void AGoombanicsDestructionManager::OnRep_HeatGrid()
+{
+	OnHeatGridChanged.Broadcast();
+}
@@ -0,0 +1,222 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "GoombanicsDestructionAggregates.h"
+#include "GoombanicsDestructionManager.generated.h"
+
+// -----------------------------------------------------------------------------
+// FGoombanicsDestructionBitset
+//
+// One bit per stable destruction index (1 = broken). NetSerialize writes the bit
+// count followed by alternating run lengths (zeros first) as packed ints, so an
+// untouched city is a few bytes and a late joiner gets every prop's state in one
+// small property update.
+// -----------------------------------------------------------------------------
+USTRUCT()
+struct GOOMBANICS_API FGoombanicsDestructionBitset
+{
+	GENERATED_BODY()
+
+	void Init(int32 InNumBits);
+	int32 Num() const { return NumBits; }
+
+	bool Get(int32 Index) const;
+
+	// Returns true if the bit changed.
+	bool Set(int32 Index, bool bValue);
+
+	int32 CountSetBits() const;
+
+	// First index >= StartIndex whose bit equals bValue, or Num() if none.
+	int32 FindNext(int32 StartIndex, bool bValue) const;
+
+	// Calls Visitor(Index, bNewValue) for every bit that differs from Previous.
+	template <typename VisitorType>
+	void ForEachChangedBit(const FGoombanicsDestructionBitset& Previous, VisitorType&& Visitor) const
+	{
+		for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+		{
+			uint32 Diff = Words[WordIndex] ^ (Previous.Words.IsValidIndex(WordIndex) ? Previous.Words[WordIndex] : 0u);
+			while (Diff)
+			{
+				const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros(Diff));
+				const int32 Index = WordIndex * 32 + Bit;
+				if (Index < NumBits)
+				{
+					Visitor(Index, (Words[WordIndex] & (1u << Bit)) != 0);
+				}
+				Diff &= Diff - 1;
+			}
+		}
+	}
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FGoombanicsDestructionBitset& Other) const { return NumBits == Other.NumBits && Words == Other.Words; }
+
+	// Upper bound accepted from the wire.
+	static constexpr int32 MaxBits = 1 << 20;
+
+private:
+	TArray<uint32> Words;
+	int32 NumBits = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDistrictDestructionChanged, int32, DistrictId, float, Percent);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnHeatGridChanged);
+
+template<>
+struct TStructOpsTypeTraits<FGoombanicsDestructionBitset> : public TStructOpsTypeTraitsBase2<FGoombanicsDestructionBitset>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+// -----------------------------------------------------------------------------
+// AGoombanicsDestructionManager
+//
+// Single always-relevant actor that replicates the broken state of every
+// level-placed breakable (actors and field instances), so breakables themselves
+// do not need channels. Clients apply broken visuals from bit flips in OnRep,
+// and restore props whose bits cleared (round reset).
+//
+// It also replicates the district / heat grid roll-up (FGoombanicsDestructionAggregates)
+// as quantized bytes: one per district plus a GridSize x GridSize grid, so the
+// HUD and minimap can show destruction without knowing about props.
+//
+// Place one per map so its PreSave bakes the stable index order (CookedBreakables)
+// at save/cook time; otherwise the destruction subsystem spawns one and falls back
+// to a deterministic path-name sort at load.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API AGoombanicsDestructionManager : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	AGoombanicsDestructionManager();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void BeginPlay() override;
+
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
+
+	// Server: size the bitset once stable indices are known.
+	void InitializeSlots(int32 NumSlots);
+
+	// Server: mark a stable index broken and push the update.
+	void SetBroken(int32 StableIndex, bool bBroken = true);
+
+	bool IsBroken(int32 StableIndex) const { return BrokenBits.Get(StableIndex); }
+
+	// Server: round reset. Clears every bit, district and heat cell in one update;
+	// clients restore the props whose bits cleared.
+	void ResetAll();
+
+	const FGoombanicsDestructionBitset& GetBrokenBits() const { return BrokenBits; }
+
+	const TArray<TObjectPtr<AActor>>& GetCookedBreakables() const { return CookedBreakables; }
+
+	// FGoombanicsBreakableManifest::ContentHash of the level as last saved.
+	uint32 GetCookedContentHash() const { return CookedContentHash; }
+
+	// Server: size the replicated district array and heat grid.
+	void InitializeAggregates(int32 NumDistricts, const FVector2D& GridOrigin, float GridCellSize);
+
+	// Server: push one quantized (0..255) value.
+	void SetDistrictDestruction(int32 DistrictId, uint8 Quantized);
+	void SetHeatCell(int32 CellIndex, uint8 Quantized);
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction|District")
+	int32 GetNumDistricts() const { return DistrictDestruction.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction|District")
+	float GetDistrictDestructionPercent(int32 DistrictId) const;
+
+	int32 GetNumAuthoredDistricts() const { return Districts.Num(); }
+
+	// Designer data for DistrictId, or null if none was authored.
+	const FGoombanicsDistrictInfo* FindDistrictInfo(int32 DistrictId) const { return Districts.IsValidIndex(DistrictId) ? &Districts[DistrictId] : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction|District")
+	FText GetDistrictDisplayName(int32 DistrictId) const;
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction|Heatmap")
+	int32 GetHeatGridSize() const { return FGoombanicsDestructionAggregates::GridSize; }
+
+	// 0..1 destruction of a heat grid cell.
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction|Heatmap")
+	float GetHeatGridValue(int32 CellX, int32 CellY) const;
+
+	// Cell containing WorldLocation (clamped to the grid).
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Destruction|Heatmap")
+	FIntPoint WorldToHeatGridCell(const FVector& WorldLocation) const;
+
+	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Destruction|Events")
+	FOnDistrictDestructionChanged OnDistrictDestructionChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Destruction|Events")
+	FOnHeatGridChanged OnHeatGridChanged;
+
+protected:
+	UFUNCTION()
+	void OnRep_BrokenBits();
+
+	UFUNCTION()
+	void OnRep_DistrictDestruction();
+
+	UFUNCTION()
+	void OnRep_HeatGrid();
+
+	// Index = breakables' DistrictId. Authored on the placed manager only.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Destruction|District")
+	TArray<FGoombanicsDistrictInfo> Districts;
+
+	// 0..255 per district.
+	UPROPERTY(ReplicatedUsing = OnRep_DistrictDestruction)
+	TArray<uint8> DistrictDestruction;
+
+	// 0..255 per cell, row-major, GridSize x GridSize.
+	UPROPERTY(ReplicatedUsing = OnRep_HeatGrid)
+	TArray<uint8> HeatGrid;
+
+	UPROPERTY(Replicated)
+	FVector2D HeatGridOrigin = FVector2D::ZeroVector;
+
+	UPROPERTY(Replicated)
+	float HeatGridCellSize = 1.0f;
+
+	// Client-side copy to report which districts changed.
+	TArray<uint8> AppliedDistrictDestruction;
+
+	void QueueAggregateEvents();
+	void BroadcastAggregateEvents();
+
+	// Server: changes since the last broadcast.
+	TArray<int32> DirtyDistricts;
+	bool bHeatGridDirty = false;
+	bool bAggregateEventsQueued = false;
+
+	UPROPERTY(ReplicatedUsing = OnRep_BrokenBits)
+	FGoombanicsDestructionBitset BrokenBits;
+
+	// Client-side copy of the last applied state, used to find flipped bits.
+	FGoombanicsDestructionBitset AppliedBits;
+	bool bReceivedBrokenBits = false;
+
+	// Breakables in this level in stable index order, baked on save.
+	UPROPERTY(VisibleAnywhere, Category = "Goombanics|Destruction")
+	TArray<TObjectPtr<AActor>> CookedBreakables;
+
+	// Baked with CookedBreakables; a manifest with another hash is stale.
+	UPROPERTY(VisibleAnywhere, Category = "Goombanics|Destruction")
+	uint32 CookedContentHash = 0;
+};
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsDestructionNavSubsystem.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavModifierComponent.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "NavAreas/NavArea.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarNavCoalesceSeconds(
+	TEXT("goombanics.Nav.CoalesceSeconds"),
+	0.25f,
+	TEXT("How long a navmesh tile collects breaks before its area changes are released.\n")
+	TEXT("Longer folds more of a collapse into one tile rebuild; shorter reacts sooner."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarNavMaxTilesPerFrame(
+	TEXT("goombanics.Nav.MaxTilesPerFrame"),
+	4,
+	TEXT("Most navmesh tiles whose area changes are released in one frame."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNavBudgetMs(
+	TEXT("goombanics.Nav.BudgetMs"),
+	0.5f,
+	TEXT("Game thread time per frame spent releasing queued nav area changes.\n")
+	TEXT("At least one ready tile is released per frame regardless."),
+	ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("Destruction Nav Updates"), STAT_GoombanicsDestructionNav, STATGROUP_Goombanics);
+
+namespace GoombanicsDestructionNav
+{
+	// Used when the world has no Recast navmesh to read a tile size from.
+	static constexpr float FallbackTileSize = 1000.0f;
+}
+
+UGoombanicsDestructionNavSubsystem* UGoombanicsDestructionNavSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGoombanicsDestructionNavSubsystem>() : nullptr;
+}
+
+bool UGoombanicsDestructionNavSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGoombanicsDestructionNavSubsystem::Deinitialize()
+{
+	PendingTiles.Reset();
+
+	Super::Deinitialize();
+}
+
+FIntPoint UGoombanicsDestructionNavSubsystem::GetTileCoord(const FVector& Location) const
+{
+	float TileSize = GoombanicsDestructionNav::FallbackTileSize;
+	if (const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		if (const ARecastNavMesh* NavMesh = Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance()))
+		{
+			TileSize = FMath::Max(1.0f, NavMesh->TileSizeUU);
+		}
+	}
+
+	return FIntPoint(FMath::FloorToInt32(Location.X / TileSize), FMath::FloorToInt32(Location.Y / TileSize));
+}
+
+void UGoombanicsDestructionNavSubsystem::QueueAreaChange(UNavModifierComponent* Modifier, TSubclassOf<UNavArea> AreaClass)
+{
+	UWorld* World = GetWorld();
+	if (!Modifier || !World || !FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		return;
+	}
+
+	const FIntPoint Tile = GetTileCoord(Modifier->GetComponentLocation());
+
+	FPendingTile* Pending = PendingTiles.FindByPredicate([&Tile](const FPendingTile& Entry) { return Entry.Tile == Tile; });
+	if (!Pending)
+	{
+		Pending = &PendingTiles.AddDefaulted_GetRef();
+		Pending->Tile = Tile;
+		Pending->FirstQueuedTime = World->GetTimeSeconds();
+	}
+
+	if (FPendingAreaChange* Existing = Pending->Changes.FindByPredicate([Modifier](const FPendingAreaChange& Change) { return Change.Modifier == Modifier; }))
+	{
+		Existing->AreaClass = AreaClass;
+	}
+	else
+	{
+		Pending->Changes.Add({ Modifier, AreaClass });
+	}
+}
+
+void UGoombanicsDestructionNavSubsystem::ApplyTile(const FPendingTile& Pending)
+{
+	// Each SetAreaClass dirties the modifier's bounds; the navmesh generator merges
+	// this frame's dirty areas into one rebuild per tile.
+	for (const FPendingAreaChange& Change : Pending.Changes)
+	{
+		if (UNavModifierComponent* Modifier = Change.Modifier.Get())
+		{
+			Modifier->SetAreaClass(Change.AreaClass);
+		}
+	}
+
+	UE_LOG(LogGoombanics, Verbose, TEXT("DestructionNav: released tile (%d, %d), %d area changes"), Pending.Tile.X, Pending.Tile.Y, Pending.Changes.Num());
+}
+
+void UGoombanicsDestructionNavSubsystem::FlushAreaChanges()
+{
+	TArray<FPendingTile> Flushed = MoveTemp(PendingTiles);
+	PendingTiles.Reset();
+
+	for (const FPendingTile& Pending : Flushed)
+	{
+		ApplyTile(Pending);
+	}
+}
+
+void UGoombanicsDestructionNavSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_GoombanicsDestructionNav);
+
+	UWorld* World = GetWorld();
+	if (!World || PendingTiles.IsEmpty())
+	{
+		return;
+	}
+
+	const double Now = World->GetTimeSeconds();
+	const double CoalesceSeconds = FMath::Max(0.0f, CVarNavCoalesceSeconds.GetValueOnGameThread());
+	const int32 MaxTiles = FMath::Max(1, CVarNavMaxTilesPerFrame.GetValueOnGameThread());
+	const double BudgetSeconds = CVarNavBudgetMs.GetValueOnGameThread() * 0.001;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Tiles are queued in time order, so the first one still collecting ends the pass.
+	int32 NumReleased = 0;
+	while (NumReleased < PendingTiles.Num() && NumReleased < MaxTiles && Now - PendingTiles[NumReleased].FirstQueuedTime >= CoalesceSeconds)
+	{
+		if (NumReleased > 0 && (FPlatformTime::Seconds() - StartTime) >= BudgetSeconds)
+		{
+			break;
+		}
+		ApplyTile(PendingTiles[NumReleased++]);
+	}
+
+	PendingTiles.RemoveAt(0, NumReleased, EAllowShrinking::No);
+}
+
+TStatId UGoombanicsDestructionNavSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGoombanicsDestructionNavSubsystem, STATGROUP_Tickables);
+}
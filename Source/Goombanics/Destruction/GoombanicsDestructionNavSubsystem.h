@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "GoombanicsDestructionNavSubsystem.generated.h"
+
+class UNavArea;
+class UNavModifierComponent;
+
+// -----------------------------------------------------------------------------
+// UGoombanicsDestructionNavSubsystem
+//
+// Server-side navmesh upkeep for destruction. Breakables do not cut the navmesh
+// with their collision; a nav modifier marks their footprint instead, and a break
+// only changes that modifier's area. Under RuntimeGeneration=DynamicModifiersOnly
+// (DefaultEngine.ini) an area change rebuilds just the tile's area layers on the
+// navmesh's worker jobs, never the geometry.
+//
+// Area changes are grouped by navmesh tile and held for CoalesceSeconds, so a
+// collapse that breaks thirty pieces of one building dirties its tiles once.
+// Ready tiles are then released oldest first, at most MaxTilesPerFrame and
+// BudgetMs of game thread time per frame (at least one tile per frame).
+//
+// Does nothing without a navigation system (clients, by default).
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API UGoombanicsDestructionNavSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGoombanicsDestructionNavSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return PendingTiles.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+
+	// Server: set Modifier's area to AreaClass with the next release of its tile.
+	// Queuing the same modifier again replaces the pending area.
+	void QueueAreaChange(UNavModifierComponent* Modifier, TSubclassOf<UNavArea> AreaClass);
+
+	// Applies every pending change now. UGoombanicsDestructionSubsystem::ResetRound
+	// calls it so last round's changes never land after the restored areas.
+	void FlushAreaChanges();
+
+	int32 GetNumPendingTiles() const { return PendingTiles.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Navmesh tile containing Location; tile size comes from the default Recast navmesh.
+	FIntPoint GetTileCoord(const FVector& Location) const;
+
+	struct FPendingAreaChange
+	{
+		TWeakObjectPtr<UNavModifierComponent> Modifier;
+		TSubclassOf<UNavArea> AreaClass;
+	};
+
+	struct FPendingTile
+	{
+		FIntPoint Tile = FIntPoint::ZeroValue;
+		double FirstQueuedTime = 0.0;
+		TArray<FPendingAreaChange> Changes;
+	};
+
+	static void ApplyTile(const FPendingTile& Pending);
+
+	// Oldest first. Rarely more than a few dozen tiles, so lookups are linear.
+	TArray<FPendingTile> PendingTiles;
+};
@@ -0,0 +1,959 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsDestructionSubsystem.h"
+#include "GoombanicsDestructionManager.h"
+#include "GoombanicsDestructionNavSubsystem.h"
+#include "GoombanicsBreakableActor.h"
+#include "GoombanicsBreakableField.h"
+#include "GoombanicsStructure.h"
+#include "Goombanics/Core/GoombanicsGameState.h"
+#include "Goombanics/Core/GoombanicsMapPreloadSubsystem.h"
+#include "Goombanics/Goombanics.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/HitResult.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarDestructionPresentationBudgetMs(
+	TEXT("goombanics.Destruction.PresentationBudgetMs"),
+	1.0f,
+	TEXT("Game thread milliseconds per frame spent applying queued break visuals and events.\n")
+	TEXT("At least one break is applied per frame. <= 0 applies every break immediately."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarDestructionPredictBreaks(
+	TEXT("goombanics.Destruction.PredictBreaks"),
+	true,
+	TEXT("Clients hide props their own shots break without waiting for the server."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDestructionPredictionTimeout(
+	TEXT("goombanics.Destruction.PredictionTimeout"),
+	1.0f,
+	TEXT("Seconds a predicted break waits for the server's bitset before it is rolled back."),
+	ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("Destruction Presentation Queue"), STAT_GoombanicsDestructionQueue, STATGROUP_Goombanics);
+DECLARE_CYCLE_STAT(TEXT("Destruction Round Reset"), STAT_GoombanicsDestructionReset, STATGROUP_Goombanics);
+
+UGoombanicsDestructionSubsystem* UGoombanicsDestructionSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGoombanicsDestructionSubsystem>() : nullptr;
+}
+
+bool UGoombanicsDestructionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGoombanicsDestructionSubsystem::Deinitialize()
+{
+	SlotOwners.Reset();
+	Positions.Reset(0);
+	Aggregates.Reset();
+	UnindexedBreakables.Reset();
+	PendingPresentations.Reset();
+	PredictedBreaks.Reset();
+	JoinSnapshotBits = FGoombanicsDestructionBitset();
+	bManagerBitsReplicated = false;
+	Manager.Reset();
+	Manifest.Reset();
+	NumSlots = 0;
+	TotalMeterValue = 0.0;
+	bIndexed = false;
+
+	Super::Deinitialize();
+}
+
+void UGoombanicsDestructionSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	EnsureIndexed();
+
+	if (InWorld.GetNetMode() != NM_Client)
+	{
+		if (!Manager.IsValid())
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.ObjectFlags |= RF_Transient;
+			SetManager(InWorld.SpawnActor<AGoombanicsDestructionManager>(SpawnParams));
+		}
+
+		if (AGoombanicsGameState* GS = InWorld.GetGameState<AGoombanicsGameState>())
+		{
+			GS->SetTotalDestructionValue(static_cast<float>(TotalMeterValue));
+		}
+	}
+}
+
+bool UGoombanicsDestructionSubsystem::IsLevelPlaced(const AActor* Actor)
+{
+	// Game worlds: only actors loaded with the level exist identically on server and
+	// clients. Anything spawned (or client-only) would shift every later index on
+	// one side; those take the unindexed path instead. Editor worlds (bake,
+	// commandlet) only hold placed actors, saved or not.
+	const UWorld* World = Actor->GetWorld();
+	if (World && World->IsGameWorld())
+	{
+		return Actor->IsNetStartupActor();
+	}
+	return !Actor->HasAnyFlags(RF_Transient);
+}
+
+void UGoombanicsDestructionSubsystem::GatherBreakables(const TArray<AActor*>& Actors, TArray<AActor*>& OutBreakables)
+{
+	TArray<TPair<FString, AActor*>> Keyed;
+	for (AActor* Actor : Actors)
+	{
+		if (IsValid(Actor) && (Actor->IsA<AGoombanicsBreakableActor>() || Actor->IsA<AGoombanicsBreakableField>()) && IsLevelPlaced(Actor))
+		{
+			Keyed.Emplace(Actor->GetPathName(), Actor);
+		}
+	}
+
+	Keyed.Sort([](const TPair<FString, AActor*>& A, const TPair<FString, AActor*>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	OutBreakables.Reserve(OutBreakables.Num() + Keyed.Num());
+	for (const TPair<FString, AActor*>& Pair : Keyed)
+	{
+		OutBreakables.Add(Pair.Value);
+	}
+}
+
+AGoombanicsDestructionManager* UGoombanicsDestructionSubsystem::FindPlacedManager(UWorld* World)
+{
+	for (TActorIterator<AGoombanicsDestructionManager> It(World); It; ++It)
+	{
+		if (!It->HasAnyFlags(RF_Transient))
+		{
+			return *It;
+		}
+	}
+	return nullptr;
+}
+
+void UGoombanicsDestructionSubsystem::BuildStableOrder(UWorld* World, TArray<AActor*>& OutBreakables)
+{
+	TSet<AActor*> Seen;
+
+	if (const AGoombanicsDestructionManager* Placed = FindPlacedManager(World))
+	{
+		for (AActor* Actor : Placed->GetCookedBreakables())
+		{
+			if (IsValid(Actor))
+			{
+				OutBreakables.Add(Actor);
+				Seen.Add(Actor);
+			}
+		}
+	}
+
+	// Anything not baked (no placed manager, or a level saved before the manager was added).
+	TArray<AActor*> Remaining;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (!Seen.Contains(*It))
+		{
+			Remaining.Add(*It);
+		}
+	}
+	GatherBreakables(Remaining, OutBreakables);
+}
+
+bool UGoombanicsDestructionSubsystem::AssignSlots(const TArray<AActor*>& Ordered)
+{
+	SlotOwners.Reset(Ordered.Num());
+	NumSlots = 0;
+	TotalMeterValue = 0.0;
+
+	const bool bUseManifest = !Manifest.IsEmpty();
+
+	for (int32 OrderIndex = 0; OrderIndex < Ordered.Num(); ++OrderIndex)
+	{
+		AActor* Actor = Ordered[OrderIndex];
+
+		FSlotOwner Owner;
+		Owner.Actor = Actor;
+		Owner.FirstIndex = NumSlots;
+
+		if (AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Actor))
+		{
+			Owner.Count = Field->GetInstanceCount();
+			Field->SetDestructionIndexBase(NumSlots);
+
+			if (!bUseManifest && Field->ContributesToDestructionMeter())
+			{
+				for (int32 Index = 0; Index < Owner.Count; ++Index)
+				{
+					TotalMeterValue += Field->GetAuthoredInstanceValue(Index);
+				}
+			}
+		}
+		else
+		{
+			AGoombanicsBreakableActor* Breakable = CastChecked<AGoombanicsBreakableActor>(Actor);
+			Owner.Count = 1;
+			Breakable->SetDestructionIndex(NumSlots);
+
+			if (!bUseManifest && Breakable->ContributesToDestructionMeter())
+			{
+				TotalMeterValue += Breakable->GetDestructionValue();
+			}
+		}
+
+		if (bUseManifest && Manifest.OwnerSlotCounts[OrderIndex] != Owner.Count)
+		{
+			return false;
+		}
+
+		if (Owner.Count > 0)
+		{
+			NumSlots += Owner.Count;
+			SlotOwners.Add(Owner);
+		}
+	}
+
+	if (bUseManifest)
+	{
+		if (NumSlots != Manifest.Num())
+		{
+			return false;
+		}
+		TotalMeterValue = Manifest.TotalMeterValue;
+	}
+	return true;
+}
+
+void UGoombanicsDestructionSubsystem::EnsureIndexed()
+{
+	UWorld* World = GetWorld();
+	if (bIndexed || !World)
+	{
+		return;
+	}
+
+	bIndexed = true;
+
+	// Fast path: baked order plus a manifest that agrees with it; no actor scan.
+	// After a rotation the manifest was already read during the previous end-of-round.
+	const AGoombanicsDestructionManager* Placed = FindPlacedManager(World);
+	const FString ManifestFilename = FGoombanicsBreakableManifest::GetFilenameForWorld(World);
+	UGoombanicsMapPreloadSubsystem* Preload = UGoombanicsMapPreloadSubsystem::Get(World);
+	if (Placed && ((Preload && Preload->TakeManifest(ManifestFilename, Manifest)) || Manifest.LoadFromFile(ManifestFilename)))
+	{
+		// A missing baked actor shifts every index after it, so the whole order is
+		// unusable; dropping or skipping it would index the rest against the wrong slots.
+		const TArray<TObjectPtr<AActor>>& Cooked = Placed->GetCookedBreakables();
+		const int32 MissingIndex = Cooked.IndexOfByPredicate([](const TObjectPtr<AActor>& Actor) { return !IsValid(Actor); });
+
+		TArray<AActor*> Ordered;
+		if (MissingIndex != INDEX_NONE)
+		{
+			UE_LOG(LogGoombanics, Warning, TEXT("DestructionSubsystem: baked breakable %d of %d in %s is missing; resave the level. Scanning instead"), MissingIndex, Cooked.Num(), *World->GetMapName());
+			Manifest.Reset();
+		}
+		else
+		{
+			Ordered.Append(Cooked);
+		}
+
+		if (!Manifest.IsEmpty() && (Manifest.ContentHash != Placed->GetCookedContentHash() || Ordered.Num() != Manifest.OwnerSlotCounts.Num() || !AssignSlots(Ordered)))
+		{
+			UE_LOG(LogGoombanics, Warning, TEXT("DestructionSubsystem: breakable manifest for %s is out of date; run the GoombanicsBreakableManifest commandlet"), *World->GetMapName());
+			Manifest.Reset();
+		}
+	}
+
+	if (Manifest.IsEmpty())
+	{
+		TArray<AActor*> Ordered;
+		BuildStableOrder(World, Ordered);
+		AssignSlots(Ordered);
+	}
+
+	BuildSlotData();
+	InitializeManagerState(Manager.Get());
+
+	UE_LOG(LogGoombanics, Log, TEXT("DestructionSubsystem: indexed %d breakables into %d slots (%s)"), SlotOwners.Num(), NumSlots, Manifest.IsEmpty() ? TEXT("scanned") : TEXT("manifest"));
+}
+
+void UGoombanicsDestructionSubsystem::BuildSlotData()
+{
+	struct FSlotData
+	{
+		FVector Position;
+		float Value;
+		int32 DistrictId;
+		bool bContributesToMeter;
+	};
+
+	TArray<FSlotData> Slots;
+	Slots.SetNumZeroed(NumSlots);
+
+	if (!Manifest.IsEmpty())
+	{
+		for (int32 Index = 0; Index < Manifest.Num(); ++Index)
+		{
+			Slots[Index] = { FVector(Manifest.Positions[Index]), Manifest.Values[Index], Manifest.DistrictIds[Index], static_cast<bool>(Manifest.MeterBits[Index]) };
+		}
+	}
+	else
+	{
+		for (const FSlotOwner& Owner : SlotOwners)
+		{
+			if (const AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Owner.Actor.Get()))
+			{
+				for (int32 Index = 0; Index < Owner.Count; ++Index)
+				{
+					Slots[Owner.FirstIndex + Index] = { Field->GetAuthoredInstanceLocation(Index), Field->GetAuthoredInstanceValue(Index), Field->GetDistrictId(), Field->ContributesToDestructionMeter() };
+				}
+			}
+			else if (const AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(Owner.Actor.Get()))
+			{
+				Slots[Owner.FirstIndex] = { Breakable->GetActorLocation(), Breakable->GetDestructionValue(), Breakable->GetDistrictId(), Breakable->ContributesToDestructionMeter() };
+			}
+		}
+	}
+
+	Positions.Reset(NumSlots);
+
+	FBox2D Bounds(ForceInit);
+	int32 NumDistricts = 1;
+	if (const AGoombanicsDestructionManager* Placed = FindPlacedManager(GetWorld()))
+	{
+		NumDistricts = FMath::Max(NumDistricts, Placed->GetNumAuthoredDistricts());
+	}
+
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		Positions.SetPosition(Index, Slots[Index].Position);
+		Bounds += FVector2D(Slots[Index].Position);
+		NumDistricts = FMath::Max(NumDistricts, Slots[Index].DistrictId + 1);
+	}
+
+	Aggregates.Init(NumSlots, NumDistricts, Bounds);
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		Aggregates.SetSlot(Index, Slots[Index].Position, Slots[Index].Value, Slots[Index].bContributesToMeter, Slots[Index].DistrictId);
+	}
+}
+
+void UGoombanicsDestructionSubsystem::InitializeManagerState(AGoombanicsDestructionManager* InManager) const
+{
+	if (InManager && InManager->GetNetMode() != NM_Client)
+	{
+		InManager->InitializeSlots(NumSlots);
+		InManager->InitializeAggregates(Aggregates.GetNumDistricts(), Aggregates.GetGridOrigin(), Aggregates.GetCellSize());
+	}
+}
+
+float UGoombanicsDestructionSubsystem::GetDistrictDestructionPercent(int32 DistrictId) const
+{
+	return Aggregates.GetDistrictPercent(DistrictId);
+}
+
+int32 UGoombanicsDestructionSubsystem::FindLostProtectedDistrict() const
+{
+	const AGoombanicsDestructionManager* CurrentManager = Manager.Get();
+	if (!CurrentManager)
+	{
+		return INDEX_NONE;
+	}
+
+	for (int32 DistrictId = 0; DistrictId < Aggregates.GetNumDistricts(); ++DistrictId)
+	{
+		const FGoombanicsDistrictInfo* Info = CurrentManager->FindDistrictInfo(DistrictId);
+		if (Info && Info->bProtected && Aggregates.GetDistrictPercent(DistrictId) >= Info->ProtectedFailPercent)
+		{
+			return DistrictId;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void UGoombanicsDestructionSubsystem::SetManager(AGoombanicsDestructionManager* InManager)
+{
+	if (!InManager || Manager.Get() == InManager)
+	{
+		return;
+	}
+
+	Manager = InManager;
+	EnsureIndexed();
+	InitializeManagerState(InManager);
+}
+
+void UGoombanicsDestructionSubsystem::NotifyBroken(int32 StableIndex)
+{
+	if (StableIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	Positions.Remove(StableIndex);
+
+	int32 DistrictId = INDEX_NONE;
+	int32 CellIndex = INDEX_NONE;
+	Aggregates.OnSlotBroken(StableIndex, DistrictId, CellIndex);
+
+	if (AGoombanicsDestructionManager* CurrentManager = Manager.Get())
+	{
+		CurrentManager->SetBroken(StableIndex);
+
+		if (DistrictId != INDEX_NONE)
+		{
+			CurrentManager->SetDistrictDestruction(DistrictId, Aggregates.GetQuantizedDistrict(DistrictId));
+			CurrentManager->SetHeatCell(CellIndex, Aggregates.GetQuantizedCell(CellIndex));
+		}
+	}
+}
+
+bool UGoombanicsDestructionSubsystem::IsBroken(int32 StableIndex) const
+{
+	const AGoombanicsDestructionManager* CurrentManager = Manager.Get();
+	return CurrentManager && CurrentManager->IsBroken(StableIndex);
+}
+
+bool UGoombanicsDestructionSubsystem::FindSlot(int32 StableIndex, AActor*& OutOwner, int32& OutLocalIndex) const
+{
+	// Last owner whose range starts at or before StableIndex.
+	const int32 OwnerIndex = Algo::UpperBoundBy(SlotOwners, StableIndex, &FSlotOwner::FirstIndex) - 1;
+	if (!SlotOwners.IsValidIndex(OwnerIndex))
+	{
+		return false;
+	}
+
+	const FSlotOwner& Owner = SlotOwners[OwnerIndex];
+	OutLocalIndex = StableIndex - Owner.FirstIndex;
+	OutOwner = Owner.Actor.Get();
+	return OutLocalIndex < Owner.Count && OutOwner;
+}
+
+void UGoombanicsDestructionSubsystem::ApplyReplicatedBreak(int32 StableIndex)
+{
+	EnsureIndexed();
+
+	AActor* Owner = nullptr;
+	int32 LocalIndex = 0;
+	if (!FindSlot(StableIndex, Owner, LocalIndex))
+	{
+		return;
+	}
+
+	// Confirms a prediction, if there was one: the regular presentation below
+	// finishes what the predicted visuals started.
+	PredictedBreaks.Remove(StableIndex);
+	Positions.Remove(StableIndex);
+
+	if (AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Owner))
+	{
+		Field->ApplyReplicatedInstanceBreak(LocalIndex);
+	}
+	else if (AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(Owner))
+	{
+		Breakable->ApplyReplicatedBreak();
+	}
+}
+
+bool UGoombanicsDestructionSubsystem::ApplyJoinSnapshotBits(const FGoombanicsDestructionBitset& Bits)
+{
+	if (bManagerBitsReplicated)
+	{
+		return false;
+	}
+
+	EnsureIndexed();
+
+	if (Bits.Num() != NumSlots)
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("DestructionSubsystem: bitset has %d slots, client indexed %d"), Bits.Num(), NumSlots);
+	}
+
+	for (int32 StableIndex = Bits.FindNext(0, true); StableIndex < Bits.Num(); StableIndex = Bits.FindNext(StableIndex + 1, true))
+	{
+		ApplyReplicatedBreak(StableIndex);
+	}
+
+	JoinSnapshotBits = Bits;
+	return true;
+}
+
+FGoombanicsDestructionBitset UGoombanicsDestructionSubsystem::TakeJoinSnapshotBits()
+{
+	bManagerBitsReplicated = true;
+	return MoveTemp(JoinSnapshotBits);
+}
+
+int32 UGoombanicsDestructionSubsystem::ResetRound()
+{
+	UWorld* World = GetWorld();
+	AGoombanicsDestructionManager* CurrentManager = Manager.Get();
+	if (!World || World->GetNetMode() == NM_Client || !CurrentManager)
+	{
+		return 0;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GoombanicsDestructionReset);
+
+	EnsureIndexed();
+
+	// Queued presentations belong to last round; applied now they would re-break the props.
+	PendingPresentations.Reset();
+
+	// Last round's area changes land now, before the restores below queue the
+	// intact areas, instead of trickling in after the reset.
+	if (UGoombanicsDestructionNavSubsystem* DestructionNav = UGoombanicsDestructionNavSubsystem::Get(World))
+	{
+		DestructionNav->FlushAreaChanges();
+	}
+
+	const FGoombanicsDestructionBitset& Bits = CurrentManager->GetBrokenBits();
+	TArray<int32> BrokenIndices;
+	BrokenIndices.Reserve(Bits.CountSetBits());
+	for (int32 StableIndex = Bits.FindNext(0, true); StableIndex < Bits.Num(); StableIndex = Bits.FindNext(StableIndex + 1, true))
+	{
+		BrokenIndices.Add(StableIndex);
+	}
+
+	CurrentManager->ResetAll();
+	RestoreSlots(BrokenIndices);
+
+	// Props without a stable index replicate on their own channel; ResetBroken
+	// sends the intact state like any other property change.
+	int32 NumUnindexedRestored = 0;
+	for (const TWeakObjectPtr<AGoombanicsBreakableActor>& WeakBreakable : UnindexedBreakables)
+	{
+		AGoombanicsBreakableActor* Breakable = WeakBreakable.Get();
+		if (Breakable && Breakable->IsBroken())
+		{
+			Breakable->ResetBroken();
+			++NumUnindexedRestored;
+		}
+	}
+
+	// Structures rebuild their intact set from the restored pieces.
+	for (TActorIterator<AGoombanicsStructure> It(World); It; ++It)
+	{
+		It->ResetSupport();
+	}
+
+	return BrokenIndices.Num() + NumUnindexedRestored;
+}
+
+void UGoombanicsDestructionSubsystem::ApplyReplicatedReset(const TArray<int32>& StableIndices)
+{
+	EnsureIndexed();
+	RestoreSlots(StableIndices);
+}
+
+void UGoombanicsDestructionSubsystem::RestoreSlots(const TArray<int32>& StableIndices)
+{
+	TArray<AGoombanicsBreakableField*, TInlineAllocator<16>> Fields;
+
+	for (const int32 StableIndex : StableIndices)
+	{
+		PredictedBreaks.Remove(StableIndex);
+
+		AActor* Owner = nullptr;
+		int32 LocalIndex = 0;
+		if (!FindSlot(StableIndex, Owner, LocalIndex))
+		{
+			continue;
+		}
+
+		if (AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Owner))
+		{
+			// Indices ascend, so a field's slots are consecutive.
+			if (Fields.IsEmpty() || Fields.Last() != Field)
+			{
+				Fields.Add(Field);
+			}
+		}
+		else if (AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(Owner))
+		{
+			Breakable->ResetBroken();
+		}
+	}
+
+	const AGoombanicsDestructionManager* CurrentManager = Manager.Get();
+
+	// Fields reset as a whole (one render update), then re-apply any instance whose
+	// bit is still set: on clients a break can follow the reset in the same update.
+	for (AGoombanicsBreakableField* Field : Fields)
+	{
+		Field->ResetBrokenInstances();
+
+		if (CurrentManager)
+		{
+			const FGoombanicsDestructionBitset& Bits = CurrentManager->GetBrokenBits();
+			const int32 FirstIndex = Field->GetDestructionIndexBase();
+			const int32 EndIndex = FMath::Min(Bits.Num(), FirstIndex + Field->GetNumInstances());
+			for (int32 StableIndex = Bits.FindNext(FirstIndex, true); StableIndex < EndIndex; StableIndex = Bits.FindNext(StableIndex + 1, true))
+			{
+				Field->ApplyReplicatedInstanceBreak(StableIndex - FirstIndex);
+			}
+		}
+	}
+
+	// Slot values and positions were consumed by the breaks; rebuild them from the
+	// manifest (or actors) rather than keeping an undo copy per slot.
+	BuildSlotData();
+
+	if (CurrentManager)
+	{
+		const FGoombanicsDestructionBitset& Bits = CurrentManager->GetBrokenBits();
+		for (int32 StableIndex = Bits.FindNext(0, true); StableIndex < Bits.Num(); StableIndex = Bits.FindNext(StableIndex + 1, true))
+		{
+			Positions.Remove(StableIndex);
+		}
+	}
+}
+
+bool UGoombanicsDestructionSubsystem::PredictBreak(int32 StableIndex)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() != NM_Client || !CVarDestructionPredictBreaks.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	EnsureIndexed();
+
+	AActor* Owner = nullptr;
+	int32 LocalIndex = 0;
+	if (PredictedBreaks.Contains(StableIndex) || IsBroken(StableIndex) || !FindSlot(StableIndex, Owner, LocalIndex))
+	{
+		return false;
+	}
+
+	bool bPredicted = false;
+	if (AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Owner))
+	{
+		bPredicted = Field->ApplyPredictedInstanceBreak(LocalIndex);
+	}
+	else if (AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(Owner))
+	{
+		bPredicted = Breakable->ApplyPredictedBreak();
+	}
+
+	if (bPredicted)
+	{
+		PredictedBreaks.Add(StableIndex, World->GetTimeSeconds());
+	}
+	return bPredicted;
+}
+
+bool UGoombanicsDestructionSubsystem::PredictBreakForHit(const FHitResult& Hit)
+{
+	const AActor* HitActor = Hit.GetActor();
+	if (const AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(HitActor))
+	{
+		return Breakable->GetDestructionIndex() != INDEX_NONE && PredictBreak(Breakable->GetDestructionIndex());
+	}
+	if (const AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(HitActor))
+	{
+		const int32 InstanceIndex = Field->GetInstanceIndexForHit(Hit);
+		return Field->GetDestructionIndexBase() != INDEX_NONE && InstanceIndex != INDEX_NONE && PredictBreak(Field->GetDestructionIndexBase() + InstanceIndex);
+	}
+	return false;
+}
+
+int32 UGoombanicsDestructionSubsystem::PredictBreakInRadius(const FVector& Center, float Radius)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() != NM_Client || !CVarDestructionPredictBreaks.GetValueOnGameThread())
+	{
+		return 0;
+	}
+
+	EnsureIndexed();
+
+	TArray<int32> Hits;
+	Positions.QuerySphere(Center, Radius, Hits);
+
+	int32 NumPredicted = 0;
+	for (const int32 StableIndex : Hits)
+	{
+		NumPredicted += PredictBreak(StableIndex) ? 1 : 0;
+	}
+	return NumPredicted;
+}
+
+void UGoombanicsDestructionSubsystem::ExpirePredictions()
+{
+	const UWorld* World = GetWorld();
+	if (!World || PredictedBreaks.IsEmpty())
+	{
+		return;
+	}
+
+	const double ExpireBefore = World->GetTimeSeconds() - CVarDestructionPredictionTimeout.GetValueOnGameThread();
+	for (auto It = PredictedBreaks.CreateIterator(); It; ++It)
+	{
+		if (It->Value > ExpireBefore)
+		{
+			continue;
+		}
+
+		// The bit may already be set with its OnRep still to come; that confirms too.
+		const int32 StableIndex = It->Key;
+		if (!IsBroken(StableIndex))
+		{
+			AActor* Owner = nullptr;
+			int32 LocalIndex = 0;
+			if (FindSlot(StableIndex, Owner, LocalIndex))
+			{
+				if (AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Owner))
+				{
+					Field->RollbackPredictedInstanceBreak(LocalIndex);
+				}
+				else if (AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(Owner))
+				{
+					Breakable->RollbackPredictedBreak();
+				}
+			}
+
+			UE_LOG(LogGoombanics, Verbose, TEXT("DestructionSubsystem: rolled back predicted break %d"), StableIndex);
+		}
+
+		It.RemoveCurrent();
+	}
+}
+
+void UGoombanicsDestructionSubsystem::QuerySphere(const FVector& Center, float Radius, TArray<int32>& OutStableIndices) const
+{
+	Positions.QuerySphere(Center, Radius, OutStableIndices);
+}
+
+int32 UGoombanicsDestructionSubsystem::BreakInRadius(const FVector& Center, float Radius, APlayerState* Instigator)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		return 0;
+	}
+
+	EnsureIndexed();
+
+	TArray<int32> Hits;
+	Positions.QuerySphere(Center, Radius, Hits);
+
+	const float RadiusSq = Radius * Radius;
+	return BreakStableIndices(Hits, Instigator)
+		+ BreakUnindexed([&Center, RadiusSq](const FVector& Location)
+		{
+			return FVector::DistSquared(Center, Location) <= RadiusSq;
+		}, Instigator);
+}
+
+int32 UGoombanicsDestructionSubsystem::BreakInCapsule(const FVector& SegmentStart, const FVector& SegmentEnd, float Radius, APlayerState* Instigator)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		return 0;
+	}
+
+	EnsureIndexed();
+
+	TArray<int32> Hits;
+	Positions.QueryCapsule(SegmentStart, SegmentEnd, Radius, Hits);
+
+	const float RadiusSq = Radius * Radius;
+	return BreakStableIndices(Hits, Instigator)
+		+ BreakUnindexed([&SegmentStart, &SegmentEnd, RadiusSq](const FVector& Location)
+		{
+			return FMath::PointDistToSegmentSquared(Location, SegmentStart, SegmentEnd) <= RadiusSq;
+		}, Instigator);
+}
+
+int32 UGoombanicsDestructionSubsystem::BreakStableIndices(const TArray<int32>& StableIndices, APlayerState* Instigator)
+{
+	int32 NumBroken = 0;
+	int32 OwnerIndex = 0;
+
+	// Indices arrive ascending, so the owner cursor only moves forward.
+	for (const int32 StableIndex : StableIndices)
+	{
+		while (OwnerIndex + 1 < SlotOwners.Num() && SlotOwners[OwnerIndex + 1].FirstIndex <= StableIndex)
+		{
+			++OwnerIndex;
+		}
+
+		if (!SlotOwners.IsValidIndex(OwnerIndex))
+		{
+			break;
+		}
+
+		const FSlotOwner& Owner = SlotOwners[OwnerIndex];
+		if (AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Owner.Actor.Get()))
+		{
+			NumBroken += Field->BreakInstance(StableIndex - Owner.FirstIndex, Instigator) ? 1 : 0;
+		}
+		else if (AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(Owner.Actor.Get()))
+		{
+			if (!Breakable->IsBroken())
+			{
+				Breakable->Break(Instigator);
+				++NumBroken;
+			}
+		}
+	}
+
+	return NumBroken;
+}
+
+void UGoombanicsDestructionSubsystem::RegisterUnindexedBreakable(AGoombanicsBreakableActor* Breakable)
+{
+	if (Breakable)
+	{
+		UnindexedBreakables.AddUnique(Breakable);
+	}
+}
+
+int32 UGoombanicsDestructionSubsystem::BreakUnindexed(TFunctionRef<bool(const FVector&)> IsInside, APlayerState* Instigator)
+{
+	int32 NumBroken = 0;
+
+	for (int32 Index = UnindexedBreakables.Num() - 1; Index >= 0; --Index)
+	{
+		AGoombanicsBreakableActor* Breakable = UnindexedBreakables[Index].Get();
+		if (!Breakable)
+		{
+			UnindexedBreakables.RemoveAtSwap(Index);
+			continue;
+		}
+
+		// Broken ones stay listed so ResetRound can restore them.
+		if (!Breakable->IsBroken() && IsInside(Breakable->GetActorLocation()))
+		{
+			Breakable->Break(Instigator);
+			++NumBroken;
+		}
+	}
+
+	return NumBroken;
+}
+
+void UGoombanicsDestructionSubsystem::QueueBrokenPresentation(AActor* Breakable, int32 InstanceIndex, const FVector& Location, APlayerState* Instigator)
+{
+	FPendingPresentation Pending;
+	Pending.Breakable = Breakable;
+	Pending.Instigator = Instigator;
+	Pending.Location = Location;
+	Pending.InstanceIndex = InstanceIndex;
+
+	if (CVarDestructionPresentationBudgetMs.GetValueOnGameThread() <= 0.0f)
+	{
+		ApplyPresentation(Pending);
+		return;
+	}
+
+	PendingPresentations.Add(Pending);
+}
+
+void UGoombanicsDestructionSubsystem::ApplyPresentation(const FPendingPresentation& Pending)
+{
+	AActor* Breakable = Pending.Breakable.Get();
+	if (!Breakable)
+	{
+		return;
+	}
+
+	if (AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(Breakable))
+	{
+		Field->ApplyInstanceBrokenPresentation(Pending.InstanceIndex, Pending.Instigator.Get());
+	}
+	else if (AGoombanicsBreakableActor* BreakableActor = Cast<AGoombanicsBreakableActor>(Breakable))
+	{
+		BreakableActor->ApplyBrokenPresentation(Pending.Instigator.Get());
+	}
+}
+
+void UGoombanicsDestructionSubsystem::FlushBrokenPresentations()
+{
+	// Presentation can break nothing new, but copy anyway so re-entrant queueing is safe.
+	TArray<FPendingPresentation> ToApply = MoveTemp(PendingPresentations);
+	PendingPresentations.Reset();
+
+	for (const FPendingPresentation& Pending : ToApply)
+	{
+		ApplyPresentation(Pending);
+	}
+}
+
+void UGoombanicsDestructionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_GoombanicsDestructionQueue);
+
+	ExpirePredictions();
+
+	UWorld* World = GetWorld();
+	if (!World || PendingPresentations.IsEmpty())
+	{
+		return;
+	}
+
+	// Local viewpoints (split-screen players). A dedicated server has none and
+	// drains in queue order.
+	TArray<FVector, TInlineAllocator<4>> Viewpoints;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			Viewpoints.Add(ViewLocation);
+		}
+	}
+
+	if (Viewpoints.Num() > 0)
+	{
+		for (FPendingPresentation& Pending : PendingPresentations)
+		{
+			float Nearest = TNumericLimits<float>::Max();
+			for (const FVector& Viewpoint : Viewpoints)
+			{
+				Nearest = FMath::Min(Nearest, static_cast<float>(FVector::DistSquared(Viewpoint, Pending.Location)));
+			}
+			Pending.Priority = Nearest;
+		}
+
+		PendingPresentations.Sort([](const FPendingPresentation& A, const FPendingPresentation& B)
+		{
+			return A.Priority < B.Priority;
+		});
+	}
+
+	const double BudgetSeconds = CVarDestructionPresentationBudgetMs.GetValueOnGameThread() * 0.001;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Copy each entry out: a Blueprint handler may break more props and grow the queue.
+	int32 NumApplied = 0;
+	do
+	{
+		const FPendingPresentation Pending = PendingPresentations[NumApplied++];
+		ApplyPresentation(Pending);
+	}
+	while (NumApplied < PendingPresentations.Num() && (FPlatformTime::Seconds() - StartTime) < BudgetSeconds);
+
+	PendingPresentations.RemoveAt(0, NumApplied, EAllowShrinking::No);
+}
+
+TStatId UGoombanicsDestructionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGoombanicsDestructionSubsystem, STATGROUP_Tickables);
+}
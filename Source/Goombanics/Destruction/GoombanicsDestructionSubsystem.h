@@ -0,0 +1,234 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GoombanicsBreakableManifest.h"
+#include "GoombanicsBreakablePositionStore.h"
+#include "GoombanicsDestructionAggregates.h"
+#include "GoombanicsDestructionManager.h"
+#include "GoombanicsDestructionSubsystem.generated.h"
+
+class AGoombanicsBreakableActor;
+class APlayerState;
+struct FHitResult;
+
+// -----------------------------------------------------------------------------
+// UGoombanicsDestructionSubsystem
+//
+// Maps stable destruction indices to level-placed breakables. A breakable actor
+// owns one index; a breakable field owns a contiguous range (one per instance).
+// Server and clients derive the same indices from the same level data:
+// - the manager's baked CookedBreakables order when present,
+// - then any remaining breakables sorted by path name.
+//
+// With a baked manifest (see FGoombanicsBreakableManifest) and a placed manager,
+// the index table, slot count and meter total come from the bake and no actors
+// are scanned at load. A manifest that no longer matches the level is ignored.
+//
+// Server: breakables report breaks here, which flips the manager's bitset.
+// Client: the manager's OnRep resolves flipped indices back to props here.
+//
+// District roll-up: each break adds its value to its district and heat grid
+// cell in O(1); the manager replicates the quantized results.
+//
+// Radial breaks (stomps, splash) test the packed position store rather than
+// iterating actors, then break the hits on the game thread in index order.
+//
+// Presentation queue: a break's gameplay state (broken bit, replication, meter)
+// is applied immediately, but its broadcast and visual/physics swap are queued
+// and drained under goombanics.Destruction.PresentationBudgetMs per frame,
+// nearest to a local viewpoint first.
+//
+// Client prediction: a client's own shots hide the props they hit at once
+// (visuals only, no scoring). The replicated bitset then confirms each predicted
+// break, or it is rolled back after goombanics.Destruction.PredictionTimeout.
+// Nothing extra is sent; the bitset already carries the truth.
+//
+// Round reset: ResetRound clears the bitset and restores the broken props in
+// place; clients restore whatever their OnRep sees cleared. Nothing respawns.
+//
+// Breakables spawned at runtime have no stable index; they replicate on their
+// own (dormant) channel instead, see AGoombanicsBreakableActor.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API UGoombanicsDestructionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGoombanicsDestructionSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return PendingPresentations.Num() > 0 || PredictedBreaks.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+
+	// Collects level-placed breakable actors and fields from Actors in deterministic
+	// (path name) order. Runtime-spawned ones are skipped (see IsLevelPlaced).
+	static void GatherBreakables(const TArray<AActor*>& Actors, TArray<AActor*>& OutBreakables);
+
+	// Every breakable in World in stable index order: the placed manager's baked
+	// CookedBreakables first, then anything else by path name. Scans all actors.
+	static void BuildStableOrder(UWorld* World, TArray<AActor*>& OutBreakables);
+
+	// True for actors that exist identically on server and clients from level load.
+	static bool IsLevelPlaced(const AActor* Actor);
+
+	void SetManager(AGoombanicsDestructionManager* InManager);
+	AGoombanicsDestructionManager* GetManager() const { return Manager.Get(); }
+
+	// Builds the index table on first use; safe to call any time after the level has loaded.
+	void EnsureIndexed();
+
+	int32 GetNumSlots() const { return NumSlots; }
+
+	// Baked data for this map, or null if none was loaded (or it was stale).
+	const FGoombanicsBreakableManifest* GetManifest() const { return Manifest.IsEmpty() ? nullptr : &Manifest; }
+
+	// Sum of values of every breakable slot that feeds the destruction meter.
+	double GetTotalMeterValue() const { return TotalMeterValue; }
+
+	// Server: exact district percent (clients read the manager's quantized copy).
+	float GetDistrictDestructionPercent(int32 DistrictId) const;
+
+	// Server: first protected district past its fail percent, or INDEX_NONE.
+	int32 FindLostProtectedDistrict() const;
+
+	// Server: record a break for replication. Ignores INDEX_NONE.
+	void NotifyBroken(int32 StableIndex);
+
+	// Client: apply broken visuals for a replicated bit flip.
+	void ApplyReplicatedBreak(int32 StableIndex);
+
+	bool IsBroken(int32 StableIndex) const;
+
+	// Server: break every intact breakable whose origin is inside the sphere or
+	// capsule. Returns the number broken. Clients return 0 (breaks replicate).
+	int32 BreakInRadius(const FVector& Center, float Radius, APlayerState* Instigator);
+	int32 BreakInCapsule(const FVector& SegmentStart, const FVector& SegmentEnd, float Radius, APlayerState* Instigator);
+
+	// Stable indices of intact breakables inside the sphere, ascending.
+	void QuerySphere(const FVector& Center, float Radius, TArray<int32>& OutStableIndices) const;
+
+	// Client: apply every set bit of a join snapshot's bitset. Dropped (returns
+	// false) once the manager's bitset has replicated: that state is authoritative,
+	// and an older snapshot could re-break props a round reset restored. Applied
+	// bits become the baseline of the manager's first replicated update, so a
+	// reset in between restores them too.
+	bool ApplyJoinSnapshotBits(const FGoombanicsDestructionBitset& Bits);
+
+	// Client: the manager's first replicated bitset arrived. Returns the join
+	// snapshot bits already shown (empty if none) for it to diff against.
+	FGoombanicsDestructionBitset TakeJoinSnapshotBits();
+
+	// Server: round reset without a level reload. Restores every broken breakable
+	// in place from the manager's bitset (no respawn), clears the bitset and
+	// district/heat roll-up, drops queued presentations, flushes queued nav area
+	// changes and resets structures.
+	// Unindexed (runtime-spawned) breakables are restored through their own channel.
+	// Returns the number of slots and unindexed props restored.
+	int32 ResetRound();
+
+	// Client: the manager's bits for StableIndices cleared (server round reset).
+	void ApplyReplicatedReset(const TArray<int32>& StableIndices);
+
+	// Client: show a break the local player's own shot caused, ahead of the server.
+	// Returns false if prediction is off, the slot is unknown or already broken.
+	bool PredictBreak(int32 StableIndex);
+
+	// Client: predict the break of the breakable (or field instance) Hit landed on.
+	bool PredictBreakForHit(const FHitResult& Hit);
+
+	// Client: predict a splash; returns the number of predicted breaks.
+	int32 PredictBreakInRadius(const FVector& Center, float Radius);
+
+	bool IsBreakPredicted(int32 StableIndex) const { return PredictedBreaks.Contains(StableIndex); }
+
+	// Breakables spawned at runtime have no stable index; radial breaks test these separately.
+	void RegisterUnindexedBreakable(AGoombanicsBreakableActor* Breakable);
+
+	// Queue the broadcast and visual/physics swap of a break. InstanceIndex is the
+	// field instance, or INDEX_NONE for a breakable actor. Applied immediately when
+	// the budget CVar is <= 0.
+	void QueueBrokenPresentation(AActor* Breakable, int32 InstanceIndex, const FVector& Location, APlayerState* Instigator);
+
+	// Applies every queued presentation now (e.g. before a round reset).
+	void FlushBrokenPresentations();
+
+	int32 GetNumPendingPresentations() const { return PendingPresentations.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	static AGoombanicsDestructionManager* FindPlacedManager(UWorld* World);
+
+	// Per-slot position, value and district (manifest or actors) -> position store and aggregates.
+	void BuildSlotData();
+
+	// Server: size the manager's bitset, district array and heat grid.
+	void InitializeManagerState(AGoombanicsDestructionManager* InManager) const;
+
+	// Game thread pass over ascending stable indices from a position query.
+	int32 BreakStableIndices(const TArray<int32>& StableIndices, APlayerState* Instigator);
+
+	// Scalar fallback for breakables without a stable index.
+	int32 BreakUnindexed(TFunctionRef<bool(const FVector&)> IsInside, APlayerState* Instigator);
+
+	// Owner of StableIndex and its local index (field instance, 0 for an actor).
+	bool FindSlot(int32 StableIndex, AActor*& OutOwner, int32& OutLocalIndex) const;
+
+	// Rolls back predictions the server did not confirm in time.
+	void ExpirePredictions();
+
+	// Restores the props owning StableIndices (ascending), then rebuilds positions
+	// and aggregates. Bits still set afterwards stay broken.
+	void RestoreSlots(const TArray<int32>& StableIndices);
+
+	// Fills SlotOwners from Ordered. Returns false if a manifest is loaded and disagrees.
+	bool AssignSlots(const TArray<AActor*>& Ordered);
+
+	struct FSlotOwner
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 FirstIndex = 0;
+		int32 Count = 1;
+	};
+
+	// Sorted by FirstIndex; resolved with a binary search.
+	TArray<FSlotOwner> SlotOwners;
+
+	struct FPendingPresentation
+	{
+		TWeakObjectPtr<AActor> Breakable;
+		TWeakObjectPtr<APlayerState> Instigator;
+		FVector Location = FVector::ZeroVector;
+		int32 InstanceIndex = INDEX_NONE;
+		float Priority = 0.0f; // distance squared to the nearest viewpoint, refreshed per frame
+	};
+
+	static void ApplyPresentation(const FPendingPresentation& Pending);
+
+	TArray<FPendingPresentation> PendingPresentations;
+
+	// Client: stable index -> world time the break was predicted.
+	TMap<int32, double> PredictedBreaks;
+
+	// Client: breaks shown from the join snapshot, until the manager's bits replicate.
+	FGoombanicsDestructionBitset JoinSnapshotBits;
+	bool bManagerBitsReplicated = false;
+
+	TWeakObjectPtr<AGoombanicsDestructionManager> Manager;
+	FGoombanicsBreakableManifest Manifest;
+	FGoombanicsBreakablePositionStore Positions;
+	FGoombanicsDestructionAggregates Aggregates;
+
+	TArray<TWeakObjectPtr<AGoombanicsBreakableActor>> UnindexedBreakables;
+
+	int32 NumSlots = 0;
+	double TotalMeterValue = 0.0;
+	bool bIndexed = false;
+};
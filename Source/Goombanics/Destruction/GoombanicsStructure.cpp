@@ -0,0 +1,350 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsStructure.h"
+#include "GoombanicsBreakableActor.h"
+#include "Goombanics/Goombanics.h"
+#include "GameFramework/PlayerState.h"
+
+AGoombanicsStructure::AGoombanicsStructure()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	// Collapses replicate as ordinary breaks.
+	bReplicates = false;
+}
+
+void AGoombanicsStructure::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	BuildGraph();
+
+	for (int32 PieceIndex = 0; PieceIndex < Pieces.Num(); ++PieceIndex)
+	{
+		if (AGoombanicsBreakableActor* Piece = Pieces[PieceIndex])
+		{
+			Piece->OnBrokenNative.AddUObject(this, &AGoombanicsStructure::OnPieceBroken, PieceIndex);
+		}
+	}
+}
+
+void AGoombanicsStructure::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The task only reads shared graph data and its own copies, but don't leave it dangling.
+	if (bSupportCheckInFlight)
+	{
+		SupportCheckTask.Wait();
+		bSupportCheckInFlight = false;
+	}
+
+	for (AGoombanicsBreakableActor* Piece : Pieces)
+	{
+		if (Piece)
+		{
+			Piece->OnBrokenNative.RemoveAll(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGoombanicsStructure::BuildGraph()
+{
+	TSharedRef<FSupportGraph> NewGraph = MakeShared<FSupportGraph>();
+	const int32 NumPieces = Pieces.Num();
+
+	NewGraph->Heights.SetNumZeroed(NumPieces);
+	NewGraph->Anchors.Init(false, NumPieces);
+	IntactPieces.Init(false, NumPieces);
+
+	for (int32 PieceIndex = 0; PieceIndex < NumPieces; ++PieceIndex)
+	{
+		if (const AGoombanicsBreakableActor* Piece = Pieces[PieceIndex])
+		{
+			NewGraph->Heights[PieceIndex] = static_cast<float>(Piece->GetActorLocation().Z);
+			IntactPieces[PieceIndex] = !Piece->IsBroken();
+		}
+	}
+
+	for (const int32 Anchor : AnchorPieces)
+	{
+		if (NewGraph->Anchors.IsValidIndex(Anchor))
+		{
+			NewGraph->Anchors[Anchor] = true;
+		}
+	}
+
+	// Counting pass, then fill: edges are stored in both directions.
+	TArray<int32> Degree;
+	Degree.SetNumZeroed(NumPieces);
+	for (const FGoombanicsSupportEdge& Edge : Supports)
+	{
+		if (Degree.IsValidIndex(Edge.PieceA) && Degree.IsValidIndex(Edge.PieceB) && Edge.PieceA != Edge.PieceB)
+		{
+			++Degree[Edge.PieceA];
+			++Degree[Edge.PieceB];
+		}
+	}
+
+	NewGraph->Offsets.SetNumUninitialized(NumPieces + 1);
+	NewGraph->Offsets[0] = 0;
+	for (int32 PieceIndex = 0; PieceIndex < NumPieces; ++PieceIndex)
+	{
+		NewGraph->Offsets[PieceIndex + 1] = NewGraph->Offsets[PieceIndex] + Degree[PieceIndex];
+	}
+
+	NewGraph->Neighbors.SetNumUninitialized(NewGraph->Offsets[NumPieces]);
+	TArray<int32> Cursor(NewGraph->Offsets.GetData(), NumPieces);
+	for (const FGoombanicsSupportEdge& Edge : Supports)
+	{
+		if (Degree.IsValidIndex(Edge.PieceA) && Degree.IsValidIndex(Edge.PieceB) && Edge.PieceA != Edge.PieceB)
+		{
+			NewGraph->Neighbors[Cursor[Edge.PieceA]++] = Edge.PieceB;
+			NewGraph->Neighbors[Cursor[Edge.PieceB]++] = Edge.PieceA;
+		}
+	}
+
+	if (NumPieces > 0 && AnchorPieces.Num() == 0)
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("Structure %s has no anchor pieces; the first break will collapse it"), *GetName());
+	}
+
+	Graph = NewGraph;
+}
+
+void AGoombanicsStructure::OnPieceBroken(AGoombanicsBreakableActor* Piece, APlayerState* Instigator, int32 PieceIndex)
+{
+	if (!IntactPieces.IsValidIndex(PieceIndex))
+	{
+		return;
+	}
+
+	IntactPieces[PieceIndex] = false;
+
+	if (bApplyingCollapse)
+	{
+		return;
+	}
+
+	PendingBrokenPieces.Add(PieceIndex);
+	PendingInstigator = Instigator;
+
+	// Launch from Tick so every break this frame shares one check.
+	TickGate.SetReason(this, TickReason_SupportCheck, true);
+}
+
+void AGoombanicsStructure::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (bSupportCheckInFlight && SupportCheckTask.IsCompleted())
+	{
+		bSupportCheckInFlight = false;
+		ApplyCollapse(SupportCheckTask.GetResult());
+		SupportCheckTask = {};
+	}
+
+	if (!bSupportCheckInFlight && PendingBrokenPieces.Num() > 0)
+	{
+		LaunchSupportCheck();
+	}
+
+	TickGate.SetReason(this, TickReason_SupportCheck, bSupportCheckInFlight || PendingBrokenPieces.Num() > 0);
+}
+
+void AGoombanicsStructure::ResetSupport()
+{
+	// Its result refers to last round's breaks; applying it would collapse restored pieces.
+	if (bSupportCheckInFlight)
+	{
+		SupportCheckTask.Wait();
+		SupportCheckTask = {};
+		bSupportCheckInFlight = false;
+	}
+
+	PendingBrokenPieces.Reset();
+	PendingInstigator.Reset();
+	TaskInstigator.Reset();
+
+	for (int32 PieceIndex = 0; PieceIndex < IntactPieces.Num(); ++PieceIndex)
+	{
+		const AGoombanicsBreakableActor* Piece = Pieces.IsValidIndex(PieceIndex) ? Pieces[PieceIndex].Get() : nullptr;
+		IntactPieces[PieceIndex] = Piece && !Piece->IsBroken();
+	}
+
+	TickGate.SetReason(this, TickReason_SupportCheck, false);
+}
+
+void AGoombanicsStructure::LaunchSupportCheck()
+{
+	TaskInstigator = PendingInstigator;
+	bSupportCheckInFlight = true;
+
+	SupportCheckTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[SharedGraph = Graph, Intact = IntactPieces, BrokenNodes = MoveTemp(PendingBrokenPieces)]()
+		{
+			return FindUnsupported(*SharedGraph, Intact, BrokenNodes);
+		});
+
+	PendingBrokenPieces.Reset();
+}
+
+TArray<int32> AGoombanicsStructure::FindUnsupported(const FSupportGraph& Graph, TBitArray<> Intact, const TArray<int32>& BrokenNodes)
+{
+	const int32 NumNodes = Graph.Num();
+
+	TBitArray<> Supported(false, NumNodes);
+	TBitArray<> Seen(false, NumNodes);
+	TArray<int32> Visited;
+	TArray<int32> Frontier;
+	TArray<int32> Unsupported;
+
+	// Lowest node first: the search heads for the ground and usually ends after a few nodes.
+	const auto LowerFirst = [&Graph](int32 A, int32 B)
+	{
+		return Graph.Heights[A] < Graph.Heights[B];
+	};
+
+	for (const int32 BrokenNode : BrokenNodes)
+	{
+		for (int32 Edge = Graph.Offsets[BrokenNode]; Edge < Graph.Offsets[BrokenNode + 1]; ++Edge)
+		{
+			const int32 Seed = Graph.Neighbors[Edge];
+			if (!Intact[Seed] || Supported[Seed])
+			{
+				continue;
+			}
+
+			bool bReachedSupport = false;
+			Visited.Reset();
+			Frontier.Reset();
+			Frontier.HeapPush(Seed, LowerFirst);
+			Seen[Seed] = true;
+			Visited.Add(Seed);
+
+			while (Frontier.Num() > 0)
+			{
+				int32 Node = INDEX_NONE;
+				Frontier.HeapPop(Node, LowerFirst, EAllowShrinking::No);
+
+				if (Graph.Anchors[Node] || Supported[Node])
+				{
+					bReachedSupport = true;
+					break;
+				}
+
+				for (int32 NodeEdge = Graph.Offsets[Node]; NodeEdge < Graph.Offsets[Node + 1]; ++NodeEdge)
+				{
+					const int32 Next = Graph.Neighbors[NodeEdge];
+					if (Intact[Next] && !Seen[Next])
+					{
+						Seen[Next] = true;
+						Visited.Add(Next);
+						Frontier.HeapPush(Next, LowerFirst);
+					}
+				}
+			}
+
+			// Everything reached is connected to the seed: all supported, or all falling.
+			for (const int32 Node : Visited)
+			{
+				Seen[Node] = false;
+				if (bReachedSupport)
+				{
+					Supported[Node] = true;
+				}
+				else
+				{
+					Intact[Node] = false;
+					Unsupported.Add(Node);
+				}
+			}
+		}
+	}
+
+	return Unsupported;
+}
+
+void AGoombanicsStructure::ApplyCollapse(const TArray<int32>& Unsupported)
+{
+	if (Unsupported.Num() == 0)
+	{
+		return;
+	}
+
+	APlayerState* Instigator = TaskInstigator.Get();
+	int32 NumCollapsed = 0;
+
+	// Breaks go through the normal path: meter and collateral via AddDestructionValue,
+	// replication via the destruction bitset, visuals via the presentation queue.
+	TGuardValue<bool> ApplyingGuard(bApplyingCollapse, true);
+	for (const int32 PieceIndex : Unsupported)
+	{
+		AGoombanicsBreakableActor* Piece = Pieces.IsValidIndex(PieceIndex) ? Pieces[PieceIndex].Get() : nullptr;
+		if (Piece && !Piece->IsBroken())
+		{
+			Piece->Break(Instigator);
+			++NumCollapsed;
+		}
+	}
+
+	if (NumCollapsed > 0)
+	{
+		OnStructureCollapsed.Broadcast(this, NumCollapsed, Instigator);
+		UE_LOG(LogGoombanics, Verbose, TEXT("Structure %s: %d pieces collapsed"), *GetName(), NumCollapsed);
+	}
+}
+
+#if WITH_EDITOR
+void AGoombanicsStructure::AutoBuildSupports()
+{
+	Modify();
+	Supports.Reset();
+	AnchorPieces.Reset();
+
+	TArray<FBox> Bounds;
+	Bounds.SetNum(Pieces.Num());
+
+	float GroundZ = TNumericLimits<float>::Max();
+	for (int32 PieceIndex = 0; PieceIndex < Pieces.Num(); ++PieceIndex)
+	{
+		if (const AGoombanicsBreakableActor* Piece = Pieces[PieceIndex])
+		{
+			Bounds[PieceIndex] = Piece->GetComponentsBoundingBox(true);
+			GroundZ = FMath::Min(GroundZ, static_cast<float>(Bounds[PieceIndex].Min.Z));
+		}
+	}
+
+	for (int32 A = 0; A < Pieces.Num(); ++A)
+	{
+		if (!Bounds[A].IsValid)
+		{
+			continue;
+		}
+
+		if (Bounds[A].Min.Z <= GroundZ + SupportContactTolerance)
+		{
+			AnchorPieces.Add(A);
+		}
+
+		const FBox Expanded = Bounds[A].ExpandBy(SupportContactTolerance);
+		for (int32 B = A + 1; B < Pieces.Num(); ++B)
+		{
+			if (Bounds[B].IsValid && Expanded.Intersect(Bounds[B]))
+			{
+				Supports.Add(FGoombanicsSupportEdge{A, B});
+			}
+		}
+	}
+
+	UE_LOG(LogGoombanics, Log, TEXT("Structure %s: %d pieces, %d supports, %d anchors"), *GetName(), Pieces.Num(), Supports.Num(), AnchorPieces.Num());
+}
+#endif
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Tasks/Task.h"
+#include "Goombanics/Core/GoombanicsTickGate.h"
+#include "GoombanicsStructure.generated.h"
+
+class AGoombanicsBreakableActor;
+class APlayerState;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnStructureCollapsed, AGoombanicsStructure*, Structure, int32, NumPiecesCollapsed, APlayerState*, Instigator);
+
+// Undirected support between two entries of AGoombanicsStructure::Pieces.
+USTRUCT(BlueprintType)
+struct FGoombanicsSupportEdge
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Structure")
+	int32 PieceA = INDEX_NONE;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Goombanics|Structure")
+	int32 PieceB = INDEX_NONE;
+};
+
+// -----------------------------------------------------------------------------
+// AGoombanicsStructure
+//
+// Support graph for one building. Pieces are breakable actors (nodes), Supports
+// are edges, AnchorPieces rest on the ground. A piece stays up while an intact
+// path connects it to an anchor; otherwise it collapses (breaks).
+//
+// Authoring: fill Pieces, then "Auto Build Supports" connects touching pieces and
+// anchors the lowest ones. Edges and anchors can be edited by hand afterwards.
+//
+// Server only. Breaks within a frame are batched; a UE::Tasks worker then
+// searches from the broken pieces' intact neighbours toward the ground
+// (best-first by height), stopping as soon as an anchor or an already-proven
+// piece is reached. Only components cut off from the ground are flooded fully,
+// never the whole building. Results come back on the next tick, and collapsed
+// pieces break through the normal Break() path (meter, collateral, replication),
+// credited to whoever broke the last support.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API AGoombanicsStructure : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AGoombanicsStructure();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+
+#if WITH_EDITOR
+	UFUNCTION(CallInEditor, Category = "Goombanics|Structure")
+	void AutoBuildSupports();
+#endif
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Structure")
+	int32 GetNumIntactPieces() const { return IntactPieces.CountSetBits(); }
+
+	// Round reset, after the pieces were restored: drops pending and in-flight
+	// checks and re-reads which pieces are intact.
+	void ResetSupport();
+
+	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Structure|Events")
+	FOnStructureCollapsed OnStructureCollapsed;
+
+protected:
+	// Immutable after BeginPlay; shared with worker tasks.
+	struct FSupportGraph
+	{
+		// CSR adjacency: neighbours of node N are Neighbors[Offsets[N] .. Offsets[N + 1]).
+		TArray<int32> Offsets;
+		TArray<int32> Neighbors;
+		TArray<float> Heights;
+		TBitArray<> Anchors;
+
+		int32 Num() const { return Heights.Num(); }
+	};
+
+	// Worker: nodes left without a path to an anchor after BrokenNodes broke.
+	static TArray<int32> FindUnsupported(const FSupportGraph& Graph, TBitArray<> Intact, const TArray<int32>& BrokenNodes);
+
+	void BuildGraph();
+	void OnPieceBroken(AGoombanicsBreakableActor* Piece, APlayerState* Instigator, int32 PieceIndex);
+	void LaunchSupportCheck();
+	void ApplyCollapse(const TArray<int32>& Unsupported);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Structure")
+	TArray<TObjectPtr<AGoombanicsBreakableActor>> Pieces;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Structure")
+	TArray<FGoombanicsSupportEdge> Supports;
+
+	// Indices into Pieces that rest on the ground.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Structure")
+	TArray<int32> AnchorPieces;
+
+	// Gap (cm) within which AutoBuildSupports treats pieces as touching / grounded.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Goombanics|Structure", meta = (ClampMin = "0.0"))
+	float SupportContactTolerance = 10.0f;
+
+	// Ticks only while breaks are pending or a support check is running.
+	enum ETickReason : uint32
+	{
+		TickReason_SupportCheck = 1 << 0,
+	};
+	FGoombanicsTickGate TickGate;
+
+	TSharedPtr<const FSupportGraph> Graph;
+	TBitArray<> IntactPieces;
+
+	TArray<int32> PendingBrokenPieces;
+	TWeakObjectPtr<APlayerState> PendingInstigator;
+
+	UE::Tasks::TTask<TArray<int32>> SupportCheckTask;
+	TWeakObjectPtr<APlayerState> TaskInstigator;
+	bool bSupportCheckInFlight = false;
+
+	// Set while breaking collapsed pieces, whose own notifications need no check.
+	bool bApplyingCollapse = false;
+};
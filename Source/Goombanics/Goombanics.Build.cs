@@ -25,7 +25,7 @@ public class Goombanics : ModuleRules
 			Path.Combine(ModuleDirectory, "Monster"),
 			Path.Combine(ModuleDirectory, "Weapons"),
 			Path.Combine(ModuleDirectory, "Destruction"),
-			Path.Combine(ModuleDirectory, "UI"),
+			Path.Combine(ModuleDirectory, "Net"),
 		});
 
 		PrivateIncludePaths.AddRange(new string[]
@@ -41,14 +41,15 @@ public class Goombanics : ModuleRules
 			"EnhancedInput",
 			"AIModule",
 			"GameplayTags",
-			"UMG",
-			"Slate",
-			"SlateCore",
-			"NetCore"
+			"NetCore",
+			"ReplicationGraph"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { 
 			"NavigationSystem"
 		});
+
+		// HUD and widgets live in the client-only GoombanicsUI module, so no UMG or
+		// Slate here: servers neither build nor load UI code.
 	}
 }
@@ -6,3 +6,7 @@
 IMPLEMENT_PRIMARY_GAME_MODULE(FDefaultGameModuleImpl, Goombanics, "Goombanics");
 
 DEFINE_LOG_CATEGORY(LogGoombanics);
+
+DEFINE_STAT(STAT_GoombanicsCharacterTicks);
+DEFINE_STAT(STAT_GoombanicsWeaponTicks);
+DEFINE_STAT(STAT_GoombanicsGameModeTicks);
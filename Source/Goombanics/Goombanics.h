@@ -3,5 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogGoombanics, Log, All);
+
+// "stat Goombanics" in the console.
+DECLARE_STATS_GROUP(TEXT("Goombanics"), STATGROUP_Goombanics, STATCAT_Advanced);
+
+// Per-frame tick counts for tick-on-demand classes (see FGoombanicsTickGate).
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Character Ticks"), STAT_GoombanicsCharacterTicks, STATGROUP_Goombanics, GOOMBANICS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Weapon Component Ticks"), STAT_GoombanicsWeaponTicks, STATGROUP_Goombanics, GOOMBANICS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("GameMode Ticks"), STAT_GoombanicsGameModeTicks, STATGROUP_Goombanics, GOOMBANICS_API);
@@ -2,15 +2,63 @@
 
 #include "GoombanicsKaijuPawn.h"
 #include "Goombanics/Player/GoombanicsCharacter.h"
-#include "Goombanics/Destruction/GoombanicsBreakableActor.h"
+#include "Goombanics/Destruction/GoombanicsDestructionSubsystem.h"
 #include "Goombanics/Goombanics.h"
 #include "Components/BoxComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/FloatingPawnMovement.h"
 #include "Engine/DamageEvents.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+
+namespace GoombanicsKaijuNet
+{
+	static constexpr int32 MaxBufferedStates = 4;
+}
+
+bool FGoombanicsKaijuNetState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// Whole units, up to +/- 2^23 per axis: plenty for a city map.
+	bOutSuccess = SerializePackedVector<1, 24>(Location, Ar);
+
+	uint16 PackedYaw = FRotator::CompressAxisToShort(Yaw);
+	Ar << PackedYaw;
+
+	uint8 PackedStates = static_cast<uint8>(AIState) | (static_cast<uint8>(Attack) << 4);
+	Ar << PackedStates;
+
+	Ar << ServerTime;
+	Ar << TeleportCounter;
+
+	if (Ar.IsLoading())
+	{
+		Yaw = FRotator::DecompressAxisFromShort(PackedYaw);
+		AIState = static_cast<EKaijuAIState>(FMath::Min<uint8>(PackedStates & 0x0F, static_cast<uint8>(EKaijuAIState::Dead)));
+		Attack = static_cast<EKaijuAttack>(FMath::Min<uint8>(PackedStates >> 4, static_cast<uint8>(EKaijuAttack::Sweep)));
+	}
+
+	if (Attack != EKaijuAttack::None)
+	{
+		Ar << AttackStartTime;
+	}
+	else if (Ar.IsLoading())
+	{
+		AttackStartTime = 0.0f;
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return bOutSuccess;
+}
 
 AGoombanicsKaijuPawn::AGoombanicsKaijuPawn()
 {
+	PrimaryActorTick.bCanEverTick = true;
+
+	// NetState carries movement; clients smooth it themselves, so a low rate is enough.
+	SetReplicateMovement(false);
+	SetNetUpdateFrequency(10.0f);
+
 	MaxHealth = 5000.0f;
 	CurrentHealth = MaxHealth;
 
@@ -36,6 +84,26 @@ AGoombanicsKaijuPawn::AGoombanicsKaijuPawn()
 	HeadHitbox->ComponentTags.Add(FName("WeakPoint_Head"));
 }
 
+void AGoombanicsKaijuPawn::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AGoombanicsKaijuPawn, NetState);
+}
+
+void AGoombanicsKaijuPawn::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// Sampled here rather than every Tick, so the state is built once per net update.
+	NetState.Location = GetActorLocation();
+	NetState.Yaw = GetActorRotation().Yaw;
+	NetState.ServerTime = GetServerTime();
+	NetState.AIState = CurrentAIState;
+	NetState.Attack = CurrentAttack;
+	NetState.AttackStartTime = CurrentAttack != EKaijuAttack::None ? AttackStartTime : 0.0f;
+}
+
 void AGoombanicsKaijuPawn::BeginPlay()
 {
 	Super::BeginPlay();
@@ -46,25 +114,121 @@ void AGoombanicsKaijuPawn::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (bAIEnabled && !bIsControlledByPlayer && !bIsDead)
+	if (HasAuthority())
+	{
+		if (bAIEnabled && !bIsControlledByPlayer && !bIsDead)
+		{
+			UpdateAI(DeltaTime);
+		}
+	}
+#if !UE_SERVER
+	else if (GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		UpdateNetSmoothing();
+	}
+#endif
+}
+
+float AGoombanicsKaijuPawn::GetServerTime() const
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GS = World ? World->GetGameState() : nullptr;
+	return GS ? static_cast<float>(GS->GetServerWorldTimeSeconds()) : (World ? World->GetTimeSeconds() : 0.0f);
+}
+
+void AGoombanicsKaijuPawn::OnRep_NetState()
+{
+	// Samples from before a teleport would smooth the Kaiju across the map; start over and snap.
+	if (!NetStateBuffer.IsEmpty() && NetState.TeleportCounter != NetStateBuffer.Last().TeleportCounter)
+	{
+		NetStateBuffer.Reset();
+	}
+
+	const bool bFirstSample = NetStateBuffer.IsEmpty();
+	if (bFirstSample || NetState.ServerTime > NetStateBuffer.Last().ServerTime)
 	{
-		UpdateAI(DeltaTime);
+		if (NetStateBuffer.Num() == GoombanicsKaijuNet::MaxBufferedStates)
+		{
+			NetStateBuffer.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+		NetStateBuffer.Add(NetState);
+	}
+
+	if (bFirstSample)
+	{
+		SetActorLocationAndRotation(NetState.Location, FRotator(0.0f, NetState.Yaw, 0.0f));
+	}
+
+	CurrentAIState = NetState.AIState;
+
+	if (NetState.Attack == EKaijuAttack::None)
+	{
+		CurrentAttack = EKaijuAttack::None;
+	}
+	else if (NetState.Attack != CurrentAttack || NetState.AttackStartTime != AttackStartTime)
+	{
+		CurrentAttack = NetState.Attack;
+		AttackStartTime = NetState.AttackStartTime;
+
+		// A late joiner may see an attack that is already over; it gets no wind-up.
+		const float TimeIntoAttack = FMath::Max(0.0f, GetServerTime() - AttackStartTime);
+		if (TimeIntoAttack < AttackDuration)
+		{
+			ReceiveAttackTelegraph(CurrentAttack, TimeIntoAttack);
+		}
 	}
+}
 
-	if (AttackCooldownRemaining > 0.0f)
+void AGoombanicsKaijuPawn::UpdateNetSmoothing()
+{
+	if (NetStateBuffer.IsEmpty())
 	{
-		AttackCooldownRemaining -= DeltaTime;
+		return;
 	}
 
-	if (bIsAttacking)
+	const float RenderTime = GetServerTime() - NetInterpolationDelay;
+	const int32 ToIndex = NetStateBuffer.IndexOfByPredicate([RenderTime](const FGoombanicsKaijuNetState& Sample)
+	{
+		return Sample.ServerTime > RenderTime;
+	});
+
+	FVector Location;
+	float Yaw;
+
+	if (ToIndex == 0)
+	{
+		// Render time has not reached the oldest sample yet; hold there.
+		Location = NetStateBuffer[0].Location;
+		Yaw = NetStateBuffer[0].Yaw;
+	}
+	else if (ToIndex != INDEX_NONE)
+	{
+		const FGoombanicsKaijuNetState& From = NetStateBuffer[ToIndex - 1];
+		const FGoombanicsKaijuNetState& To = NetStateBuffer[ToIndex];
+		const float Alpha = FMath::Clamp((RenderTime - From.ServerTime) / FMath::Max(To.ServerTime - From.ServerTime, UE_KINDA_SMALL_NUMBER), 0.0f, 1.0f);
+		Location = FMath::Lerp(From.Location, To.Location, Alpha);
+		Yaw = From.Yaw + FMath::FindDeltaAngleDegrees(From.Yaw, To.Yaw) * Alpha;
+	}
+	else
 	{
-		AttackTimeRemaining -= DeltaTime;
-		if (AttackTimeRemaining <= 0.0f)
+		// Newest sample is late: carry on at its velocity for a short while.
+		const FGoombanicsKaijuNetState& Last = NetStateBuffer.Last();
+		Location = Last.Location;
+		Yaw = Last.Yaw;
+
+		if (NetStateBuffer.Num() >= 2)
 		{
-			bIsAttacking = false;
-			CurrentAIState = EKaijuAIState::Pursuing;
+			const FGoombanicsKaijuNetState& Previous = NetStateBuffer[NetStateBuffer.Num() - 2];
+			const float SampleDelta = Last.ServerTime - Previous.ServerTime;
+			if (SampleDelta > UE_KINDA_SMALL_NUMBER)
+			{
+				const float Ahead = FMath::Min(RenderTime - Last.ServerTime, MaxNetExtrapolation);
+				Location += (Last.Location - Previous.Location) * (Ahead / SampleDelta);
+			}
 		}
 	}
+
+	SetActorLocationAndRotation(Location, FRotator(0.0f, Yaw, 0.0f));
 }
 
 void AGoombanicsKaijuPawn::TriggerStagger_Implementation()
@@ -72,6 +236,9 @@ void AGoombanicsKaijuPawn::TriggerStagger_Implementation()
 	Super::TriggerStagger_Implementation();
 	CurrentAIState = EKaijuAIState::Staggered;
 	bIsAttacking = false;
+	CurrentAttack = EKaijuAttack::None;
+
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, AttackTimerHandle);
 }
 
 void AGoombanicsKaijuPawn::EndStagger_Implementation()
@@ -83,6 +250,23 @@ void AGoombanicsKaijuPawn::EndStagger_Implementation()
 	}
 }
 
+void AGoombanicsKaijuPawn::ResetMonster(const FTransform& SpawnTransform)
+{
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, AttackTimerHandle);
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, AttackCooldownTimerHandle);
+
+	bIsAttacking = false;
+	bAttackOnCooldown = false;
+	CurrentAttack = EKaijuAttack::None;
+	CurrentTarget.Reset();
+
+	Super::ResetMonster(SpawnTransform);
+
+	CurrentAIState = EKaijuAIState::Idle;
+	++NetState.TeleportCounter;
+	ForceNetUpdate();
+}
+
 void AGoombanicsKaijuPawn::SetAIEnabled(bool bEnabled)
 {
 	bAIEnabled = bEnabled;
@@ -94,16 +278,11 @@ void AGoombanicsKaijuPawn::SetAIEnabled(bool bEnabled)
 
 void AGoombanicsKaijuPawn::PerformStompAttack()
 {
-	if (bIsAttacking || AttackCooldownRemaining > 0.0f || bIsStaggered)
+	if (!BeginAttack(EKaijuAttack::Stomp))
 	{
 		return;
 	}
 
-	bIsAttacking = true;
-	AttackTimeRemaining = AttackDuration;
-	AttackCooldownRemaining = AttackCooldown;
-	CurrentAIState = EKaijuAIState::Attacking;
-
 	FVector AttackCenter = GetActorLocation() + FVector(0.0f, 0.0f, -200.0f);
 	ApplyAttackDamage(AttackCenter, StompRadius, StompDamage);
 	DamageNearbyDestructibles(AttackCenter, DestructionRadius);
@@ -113,23 +292,57 @@ void AGoombanicsKaijuPawn::PerformStompAttack()
 
 void AGoombanicsKaijuPawn::PerformSweepAttack()
 {
-	if (bIsAttacking || AttackCooldownRemaining > 0.0f || bIsStaggered)
+	if (!BeginAttack(EKaijuAttack::Sweep))
 	{
 		return;
 	}
 
-	bIsAttacking = true;
-	AttackTimeRemaining = AttackDuration;
-	AttackCooldownRemaining = AttackCooldown;
-	CurrentAIState = EKaijuAIState::Attacking;
-
 	FVector AttackCenter = GetActorLocation() + GetActorForwardVector() * 300.0f;
 	ApplyAttackDamage(AttackCenter, SweepRadius, SweepDamage);
-	DamageNearbyDestructibles(AttackCenter, DestructionRadius);
+
+	// The tail/arm swings from the body out to the attack point.
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		Destruction->BreakInCapsule(GetActorLocation(), AttackCenter, DestructionRadius, nullptr);
+	}
 
 	UE_LOG(LogGoombanics, Verbose, TEXT("Kaiju sweep attack"));
 }
 
+bool AGoombanicsKaijuPawn::BeginAttack(EKaijuAttack Attack)
+{
+	if (bIsAttacking || bAttackOnCooldown || bIsStaggered || !HasAuthority())
+	{
+		return false;
+	}
+
+	bIsAttacking = true;
+	bAttackOnCooldown = true;
+	AttackTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, AttackDuration, FSimpleDelegate::CreateUObject(this, &AGoombanicsKaijuPawn::OnAttackFinished));
+	AttackCooldownTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, AttackCooldown, FSimpleDelegate::CreateUObject(this, &AGoombanicsKaijuPawn::OnAttackCooldownElapsed));
+	CurrentAIState = EKaijuAIState::Attacking;
+	CurrentAttack = Attack;
+	AttackStartTime = GetServerTime();
+	ForceNetUpdate();
+
+	ReceiveAttackTelegraph(Attack, 0.0f);
+	return true;
+}
+
+void AGoombanicsKaijuPawn::OnAttackFinished()
+{
+	AttackTimerHandle.Invalidate();
+	bIsAttacking = false;
+	CurrentAttack = EKaijuAttack::None;
+	CurrentAIState = EKaijuAIState::Pursuing;
+}
+
+void AGoombanicsKaijuPawn::OnAttackCooldownElapsed()
+{
+	AttackCooldownTimerHandle.Invalidate();
+	bAttackOnCooldown = false;
+}
+
 void AGoombanicsKaijuPawn::UpdateAI(float DeltaTime)
 {
 	if (CurrentAIState == EKaijuAIState::Dead || CurrentAIState == EKaijuAIState::Staggered)
@@ -158,7 +371,7 @@ void AGoombanicsKaijuPawn::UpdateAI(float DeltaTime)
 
 	float DistanceToTarget = FVector::Dist(GetActorLocation(), CurrentTarget->GetActorLocation());
 
-	if (DistanceToTarget <= AttackRange && AttackCooldownRemaining <= 0.0f)
+	if (DistanceToTarget <= AttackRange && !bAttackOnCooldown)
 	{
 		SelectAttack();
 	}
@@ -248,18 +461,8 @@ void AGoombanicsKaijuPawn::ApplyAttackDamage(const FVector& Center, float Radius
 
 void AGoombanicsKaijuPawn::DamageNearbyDestructibles(const FVector& Center, float Radius)
 {
-	TArray<AActor*> Destructibles;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AGoombanicsBreakableActor::StaticClass(), Destructibles);
-
-	for (AActor* Actor : Destructibles)
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
 	{
-		float Distance = FVector::Dist(Center, Actor->GetActorLocation());
-		if (Distance <= Radius)
-		{
-			if (AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(Actor))
-			{
-				Breakable->Break(nullptr);
-			}
-		}
+		Destruction->BreakInRadius(Center, Radius, nullptr);
 	}
 }
@@ -18,6 +18,63 @@ enum class EKaijuAIState : uint8
 	Dead		UMETA(DisplayName = "Dead")
 };
 
+UENUM(BlueprintType)
+enum class EKaijuAttack : uint8
+{
+	None		UMETA(DisplayName = "None"),
+	Stomp		UMETA(DisplayName = "Stomp"),
+	Sweep		UMETA(DisplayName = "Sweep")
+};
+
+// -----------------------------------------------------------------------------
+// FGoombanicsKaijuNetState
+//
+// Everything clients need to draw the Kaiju, written by the server once per net
+// update (PreReplication) in place of default movement replication. On the wire:
+// position packed to whole units, yaw in 16 bits, AI state and attack in one
+// byte, the sample's server time, a teleport counter byte, and the attack start
+// time only while attacking.
+// -----------------------------------------------------------------------------
+USTRUCT()
+struct GOOMBANICS_API FGoombanicsKaijuNetState
+{
+	GENERATED_BODY()
+
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.0f;
+
+	// Server world time the sample was taken at.
+	float ServerTime = 0.0f;
+
+	// Server world time the current attack began; meaningful while Attack != None.
+	float AttackStartTime = 0.0f;
+
+	EKaijuAIState AIState = EKaijuAIState::Idle;
+	EKaijuAttack Attack = EKaijuAttack::None;
+
+	// Bumped by the server on a teleport (ResetMonster); proxies drop older samples and snap.
+	uint8 TeleportCounter = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FGoombanicsKaijuNetState& Other) const
+	{
+		return Location == Other.Location && Yaw == Other.Yaw && ServerTime == Other.ServerTime
+			&& AttackStartTime == Other.AttackStartTime && AIState == Other.AIState && Attack == Other.Attack
+			&& TeleportCounter == Other.TeleportCounter;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FGoombanicsKaijuNetState> : public TStructOpsTypeTraitsBase2<FGoombanicsKaijuNetState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
 UCLASS()
 class GOOMBANICS_API AGoombanicsKaijuPawn : public AGoombanicsMonsterBase
 {
@@ -45,12 +102,24 @@ public:
 	// TODO(Phase2-Windows): Externalize Kaiju tuning (health/stagger duration/head multiplier)
 	// into a UDataAsset (see GoombanicsGameplayTuningData).
 	// TODO(Chaos): On heavy attacks, trigger controlled Chaos setpieces without breaking readability.
+	//
+	// Networking:
+	// - AI and attacks run on the server only.
+	// - Movement replicates through NetState (see FGoombanicsKaijuNetState), not
+	//   ReplicatedMovement; simulated proxies render NetInterpolationDelay behind
+	//   the server, interpolating between samples and extrapolating briefly when
+	//   one is late.
+	// - Attack telegraphs (ReceiveAttackTelegraph) start from the replicated
+	//   attack start time, so every client's wind-up lines up with the server's.
 	// -----------------------------------------------------------------------------
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void TriggerStagger_Implementation() override;
 	virtual void EndStagger_Implementation() override;
+	virtual void ResetMonster(const FTransform& SpawnTransform) override;
 
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Kaiju|AI")
 	void SetAIEnabled(bool bEnabled);
@@ -67,12 +136,31 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Goombanics|Kaiju")
 	AActor* GetCurrentTarget() const { return CurrentTarget.Get(); }
 
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Kaiju|Attacks")
+	EKaijuAttack GetCurrentAttack() const { return CurrentAttack; }
+
 protected:
+	// Wind-up pose and audio cue. TimeIntoAttack is how far the server already is
+	// into the attack (0 on the server, about one-way latency on clients).
+	UFUNCTION(BlueprintImplementableEvent, Category = "Goombanics|Kaiju|Attacks", meta = (DisplayName = "On Attack Telegraph"))
+	void ReceiveAttackTelegraph(EKaijuAttack Attack, float TimeIntoAttack);
+
+	UFUNCTION()
+	void OnRep_NetState();
+
+	// Simulated proxies: place the Kaiju from the buffered NetState samples.
+	void UpdateNetSmoothing();
+
+	float GetServerTime() const;
+
 	virtual void UpdateAI(float DeltaTime);
 	virtual void UpdatePursuit(float DeltaTime);
 	virtual void UpdateAttack(float DeltaTime);
 	virtual AActor* FindNearestPlayer() const;
 	virtual void SelectAttack();
+	bool BeginAttack(EKaijuAttack Attack);
+	void OnAttackFinished();
+	void OnAttackCooldownElapsed();
 	virtual void ApplyAttackDamage(const FVector& Center, float Radius, float Damage);
 	virtual void DamageNearbyDestructibles(const FVector& Center, float Radius);
 
@@ -115,15 +203,33 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Kaiju|Attacks")
 	float AttackDuration = 1.0f;
 
+	// How far behind the server simulated proxies render; about two net updates.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Kaiju|Network")
+	float NetInterpolationDelay = 0.25f;
+
+	// Longest a simulated proxy keeps moving past its newest sample.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Kaiju|Network")
+	float MaxNetExtrapolation = 0.3f;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Kaiju|AI")
 	EKaijuAIState CurrentAIState = EKaijuAIState::Idle;
 
+	UPROPERTY(ReplicatedUsing = OnRep_NetState)
+	FGoombanicsKaijuNetState NetState;
+
+	// Simulated proxies: newest samples by ServerTime, oldest first.
+	TArray<FGoombanicsKaijuNetState, TInlineAllocator<4>> NetStateBuffer;
+
+	EKaijuAttack CurrentAttack = EKaijuAttack::None;
+	float AttackStartTime = 0.0f;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Kaiju|AI")
 	TWeakObjectPtr<AActor> CurrentTarget;
 
 	bool bAIEnabled = true;
-	float AttackCooldownRemaining = 0.0f;
+	bool bAttackOnCooldown = false;
 	float TargetUpdateTimer = 0.0f;
-	float AttackTimeRemaining = 0.0f;
 	bool bIsAttacking = false;
+	FGoombanicsTimerHandle AttackTimerHandle;
+	FGoombanicsTimerHandle AttackCooldownTimerHandle;
 };
@@ -12,7 +12,8 @@
 
 AGoombanicsMonsterBase::AGoombanicsMonsterBase()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Stagger runs on the timer wheel; subclasses with per-frame behavior (AI) opt back in.
+	PrimaryActorTick.bCanEverTick = false;
 
 	CapsuleComponent = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CapsuleComponent"));
 	CapsuleComponent->InitCapsuleSize(200.0f, 500.0f);
@@ -39,12 +40,6 @@ void AGoombanicsMonsterBase::BeginPlay()
 	UpdateGameState();
 }
 
-void AGoombanicsMonsterBase::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-	UpdateStagger(DeltaTime);
-}
-
 void AGoombanicsMonsterBase::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
@@ -150,6 +145,8 @@ void AGoombanicsMonsterBase::TriggerStagger_Implementation()
 		bIsStaggered = true;
 		StaggerTimeRemaining = StaggerDuration;
 
+		StaggerTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, StaggerDuration, FSimpleDelegate::CreateUObject(this, &AGoombanicsMonsterBase::OnStaggerElapsed));
+
 		if (AGoombanicsGameState* GS = Cast<AGoombanicsGameState>(UGameplayStatics::GetGameState(GetWorld())))
 		{
 			GS->SetKaijuStaggered(true);
@@ -166,6 +163,8 @@ void AGoombanicsMonsterBase::EndStagger_Implementation()
 		bIsStaggered = false;
 		StaggerTimeRemaining = 0.0f;
 
+		UGoombanicsTimerWheelSubsystem::CancelTimer(this, StaggerTimerHandle);
+
 		if (AGoombanicsGameState* GS = Cast<AGoombanicsGameState>(UGameplayStatics::GetGameState(GetWorld())))
 		{
 			GS->SetKaijuStaggered(false);
@@ -222,16 +221,38 @@ void AGoombanicsMonsterBase::Die(AController* Killer)
 	UE_LOG(LogGoombanics, Log, TEXT("Monster died"));
 }
 
-void AGoombanicsMonsterBase::UpdateStagger(float DeltaTime)
+void AGoombanicsMonsterBase::ResetMonster(const FTransform& SpawnTransform)
 {
-	if (bIsStaggered)
+	bIsDead = false;
+	CurrentHealth = MaxHealth;
+
+	for (FGoombanicsWeakPointState& WP : WeakPoints)
 	{
-		StaggerTimeRemaining -= DeltaTime;
-		if (StaggerTimeRemaining <= 0.0f)
-		{
-			Execute_EndStagger(this);
-		}
+		WP.CurrentHealth = WP.MaxHealth;
+		WP.bIsDestroyed = false;
 	}
+
+	Execute_EndStagger(this);
+
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	MovementComponent->StopMovementImmediately();
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	UpdateGameState();
+
+	UE_LOG(LogGoombanics, Log, TEXT("Monster reset at %s"), *SpawnTransform.GetLocation().ToString());
+}
+
+float AGoombanicsMonsterBase::GetStaggerTimeRemaining() const
+{
+	return UGoombanicsTimerWheelSubsystem::GetTimerRemaining(this, StaggerTimerHandle);
+}
+
+void AGoombanicsMonsterBase::OnStaggerElapsed()
+{
+	StaggerTimerHandle.Invalidate();
+	Execute_EndStagger(this);
 }
 
 void AGoombanicsMonsterBase::CheckStaggerConditions()
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 #include "GoombanicsMonsterInterface.h"
+#include "Goombanics/Core/GoombanicsTimerWheelSubsystem.h"
 #include "GoombanicsMonsterBase.generated.h"
 
 class USkeletalMeshComponent;
@@ -20,7 +21,6 @@ public:
 	AGoombanicsMonsterBase();
 
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
 	virtual void PossessedBy(AController* NewController) override;
 	virtual void UnPossessed() override;
 
@@ -52,8 +52,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Monster")
 	void Die(AController* Killer);
 
+	// Server: round reset without respawning. Full health and weak points, stagger
+	// and death cleared, visible again and teleported to SpawnTransform.
+	UFUNCTION(BlueprintCallable, Category = "Goombanics|Monster")
+	virtual void ResetMonster(const FTransform& SpawnTransform);
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Stagger")
+	float GetStaggerTimeRemaining() const;
+
 protected:
-	virtual void UpdateStagger(float DeltaTime);
+	void OnStaggerElapsed();
 	virtual void CheckStaggerConditions();
 	virtual void OnWeakPointDestroyed(EGoombanicsWeakPointType WeakPointType, AController* Destroyer);
 	virtual void OnDeath(AController* Killer);
@@ -86,9 +94,13 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Stagger")
 	bool bIsStaggered = false;
 
-	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Stagger")
+	// Kept for Blueprints and widgets that read it. The stagger is a timer now, so
+	// this is only set at stagger start (StaggerDuration) and end (0) and does not count down.
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Stagger", meta = (DeprecatedProperty, DeprecationMessage = "Use GetStaggerTimeRemaining()"))
 	float StaggerTimeRemaining = 0.0f;
 
+	FGoombanicsTimerHandle StaggerTimerHandle;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|State")
 	bool bIsControlledByPlayer = false;
 
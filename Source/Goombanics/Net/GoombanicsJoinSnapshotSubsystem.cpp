@@ -0,0 +1,357 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsJoinSnapshotSubsystem.h"
+#include "Goombanics/Core/GoombanicsGameState.h"
+#include "Goombanics/Player/GoombanicsPlayerState.h"
+#include "Goombanics/Monster/GoombanicsKaijuPawn.h"
+#include "Goombanics/Destruction/GoombanicsDestructionSubsystem.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarJoinSnapshot(
+	TEXT("goombanics.Net.JoinSnapshot"),
+	true,
+	TEXT("Server sends a compressed join snapshot to every remote player that joins.\n")
+	TEXT("0 leaves late joiners to build their state from actor replication alone."),
+	ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("Join Snapshot"), STAT_GoombanicsJoinSnapshot, STATGROUP_Goombanics);
+
+namespace GoombanicsJoinSnapshot
+{
+	enum EFlags : uint8
+	{
+		Flag_HasKaiju = 1 << 0,
+		Flag_KaijuStaggered = 1 << 1,
+		Flag_TotalledAchieved = 1 << 2,
+	};
+
+	// High bit of a weak point's type byte.
+	static constexpr uint8 WeakPointDestroyedBit = 0x80;
+
+	static const FName CompressionFormat = NAME_Oodle;
+}
+
+bool FGoombanicsJoinSnapshot::Serialize(FArchive& Ar)
+{
+	uint8 WireVersion = Version;
+	Ar << WireVersion;
+	if (WireVersion != Version)
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	// Match clock and phase.
+	uint8 Phase = static_cast<uint8>(MatchPhase);
+	Ar << ServerWorldTime;
+	Ar << TimeRemaining;
+	Ar << Phase;
+
+	// Kaiju.
+	uint8 Flags = (bHasKaiju ? GoombanicsJoinSnapshot::Flag_HasKaiju : 0)
+		| (bKaijuStaggered ? GoombanicsJoinSnapshot::Flag_KaijuStaggered : 0)
+		| (bTotalledAchieved ? GoombanicsJoinSnapshot::Flag_TotalledAchieved : 0);
+	Ar << Flags;
+	Ar << KaijuHealthPercent;
+	if (Flags & GoombanicsJoinSnapshot::Flag_HasKaiju)
+	{
+		Ar << KaijuPlayerId;
+		Ar << KaijuLocation;
+		Ar << KaijuYaw;
+	}
+
+	// Weak points.
+	uint32 NumWeakPoints = static_cast<uint32>(WeakPoints.Num());
+	Ar.SerializeIntPacked(NumWeakPoints);
+	if (Ar.IsLoading())
+	{
+		if (NumWeakPoints > static_cast<uint32>(MaxWeakPoints))
+		{
+			Ar.SetError();
+			return false;
+		}
+		WeakPoints.SetNum(static_cast<int32>(NumWeakPoints));
+	}
+	for (FGoombanicsWeakPointState& WeakPoint : WeakPoints)
+	{
+		uint8 TypeAndDestroyed = static_cast<uint8>(WeakPoint.WeakPointType) | (WeakPoint.bIsDestroyed ? GoombanicsJoinSnapshot::WeakPointDestroyedBit : 0);
+		Ar << TypeAndDestroyed;
+		Ar << WeakPoint.CurrentHealth;
+		Ar << WeakPoint.MaxHealth;
+		WeakPoint.WeakPointType = static_cast<EGoombanicsWeakPointType>(TypeAndDestroyed & ~GoombanicsJoinSnapshot::WeakPointDestroyedBit);
+		WeakPoint.bIsDestroyed = (TypeAndDestroyed & GoombanicsJoinSnapshot::WeakPointDestroyedBit) != 0;
+	}
+
+	// Destruction meter and bitset.
+	Ar << DestructionPercent;
+	Ar << CurrentDestructionValue;
+	Ar << TotalDestructionValue;
+
+	bool bBitsOk = true;
+	BrokenBits.NetSerialize(Ar, nullptr, bBitsOk);
+	if (!bBitsOk)
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	// Score table.
+	uint32 NumPlayers = static_cast<uint32>(Players.Num());
+	Ar.SerializeIntPacked(NumPlayers);
+	if (Ar.IsLoading())
+	{
+		if (NumPlayers > static_cast<uint32>(MaxPlayers))
+		{
+			Ar.SetError();
+			return false;
+		}
+		Players.SetNum(static_cast<int32>(NumPlayers));
+	}
+	for (FGoombanicsJoinSnapshotPlayer& Player : Players)
+	{
+		uint8 PlayerRole = static_cast<uint8>(Player.Role);
+		Ar << Player.PlayerId;
+		Ar << PlayerRole;
+		Ar << Player.ScoreData.KaijuDamageDealt;
+		Ar << Player.ScoreData.CollateralDamageScore;
+		Ar << Player.ScoreData.WeakPointsDestroyed;
+		Ar << Player.ScoreData.Deaths;
+		Ar << Player.ScoreData.FinalBlowCount;
+		Ar << Player.ScoreData.TotalScore;
+		Player.Role = static_cast<EGoombanicsRole>(PlayerRole);
+	}
+
+	MatchPhase = static_cast<EGoombanicsMatchPhase>(Phase);
+	bHasKaiju = (Flags & GoombanicsJoinSnapshot::Flag_HasKaiju) != 0;
+	bKaijuStaggered = (Flags & GoombanicsJoinSnapshot::Flag_KaijuStaggered) != 0;
+	bTotalledAchieved = (Flags & GoombanicsJoinSnapshot::Flag_TotalledAchieved) != 0;
+
+	return !Ar.IsError();
+}
+
+UGoombanicsJoinSnapshotSubsystem* UGoombanicsJoinSnapshotSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGoombanicsJoinSnapshotSubsystem>() : nullptr;
+}
+
+bool UGoombanicsJoinSnapshotSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGoombanicsJoinSnapshotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// The net mode is not known yet; Tick stops measuring on listen servers.
+	JoinStartTime = FPlatformTime::Seconds();
+	bMeasuringJoin = !UE_SERVER;
+}
+
+void UGoombanicsJoinSnapshotSubsystem::Deinitialize()
+{
+	PendingBytes.Empty();
+	Snapshot = FGoombanicsJoinSnapshot();
+	bHasSnapshot = false;
+	bMeasuringJoin = false;
+
+	Super::Deinitialize();
+}
+
+void UGoombanicsJoinSnapshotSubsystem::BuildSnapshot(FGoombanicsJoinSnapshot& OutSnapshot) const
+{
+	UWorld* World = GetWorld();
+	const AGoombanicsGameState* GS = World ? World->GetGameState<AGoombanicsGameState>() : nullptr;
+	if (!GS)
+	{
+		return;
+	}
+
+	OutSnapshot.ServerWorldTime = static_cast<float>(GS->GetServerWorldTimeSeconds());
+	OutSnapshot.MatchPhase = GS->GetMatchPhase();
+	OutSnapshot.TimeRemaining = GS->GetTimeRemaining();
+
+	OutSnapshot.KaijuHealthPercent = GS->GetKaijuHealthPercent();
+	OutSnapshot.bKaijuStaggered = GS->IsKaijuStaggered();
+	OutSnapshot.bTotalledAchieved = GS->IsTotalledAchieved();
+	OutSnapshot.WeakPoints = GS->GetWeakPointStates();
+
+	for (TActorIterator<AGoombanicsKaijuPawn> It(World); It; ++It)
+	{
+		const AGoombanicsKaijuPawn* Kaiju = *It;
+		const APlayerState* KaijuPlayer = Kaiju->GetPlayerState();
+		OutSnapshot.bHasKaiju = true;
+		OutSnapshot.KaijuPlayerId = KaijuPlayer ? KaijuPlayer->GetPlayerId() : INDEX_NONE;
+		OutSnapshot.KaijuLocation = Kaiju->GetActorLocation();
+		OutSnapshot.KaijuYaw = Kaiju->GetActorRotation().Yaw;
+		break;
+	}
+
+	OutSnapshot.DestructionPercent = GS->GetDestructionPercent();
+	OutSnapshot.CurrentDestructionValue = GS->GetCurrentDestructionValue();
+	OutSnapshot.TotalDestructionValue = GS->GetTotalDestructionValue();
+
+	const UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(World);
+	if (const AGoombanicsDestructionManager* Manager = Destruction ? Destruction->GetManager() : nullptr)
+	{
+		OutSnapshot.BrokenBits = Manager->GetBrokenBits();
+	}
+
+	OutSnapshot.Players.Reset(GS->PlayerArray.Num());
+	for (const APlayerState* PlayerState : GS->PlayerArray)
+	{
+		if (const AGoombanicsPlayerState* PS = Cast<AGoombanicsPlayerState>(PlayerState))
+		{
+			FGoombanicsJoinSnapshotPlayer& Player = OutSnapshot.Players.AddDefaulted_GetRef();
+			Player.PlayerId = PS->GetPlayerId();
+			Player.Role = PS->GetRole();
+			Player.ScoreData = PS->GetScoreData();
+
+			if (OutSnapshot.Players.Num() == FGoombanicsJoinSnapshot::MaxPlayers)
+			{
+				break;
+			}
+		}
+	}
+}
+
+void UGoombanicsJoinSnapshotSubsystem::SendTo(AGoombanicsPlayerState* PlayerState)
+{
+	const UWorld* World = GetWorld();
+	if (!PlayerState || !World || World->GetNetMode() == NM_Client || World->GetNetMode() == NM_Standalone || !CVarJoinSnapshot.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	const APlayerController* PC = PlayerState->GetPlayerController();
+	if (!PC || PC->IsLocalController())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GoombanicsJoinSnapshot);
+
+	FGoombanicsJoinSnapshot NewSnapshot;
+	BuildSnapshot(NewSnapshot);
+
+	TArray<uint8> Raw;
+	FMemoryWriter Writer(Raw);
+	NewSnapshot.Serialize(Writer);
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(GoombanicsJoinSnapshot::CompressionFormat, Raw.Num());
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(GoombanicsJoinSnapshot::CompressionFormat, Compressed.GetData(), CompressedSize, Raw.GetData(), Raw.Num()))
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("JoinSnapshot: compression failed (%d bytes), not sent"), Raw.Num());
+		return;
+	}
+
+	// Reliable RPCs on one actor arrive in order, so the client reassembles by appending.
+	for (int32 Offset = 0; Offset < CompressedSize; Offset += ChunkSize)
+	{
+		const TArray<uint8> Chunk(Compressed.GetData() + Offset, FMath::Min(ChunkSize, CompressedSize - Offset));
+		PlayerState->ClientReceiveJoinSnapshotChunk(Chunk, CompressedSize, Raw.Num());
+	}
+
+	UE_LOG(LogGoombanics, Log, TEXT("JoinSnapshot: sent to %s, %d bytes (%d raw, %d broken of %d slots, %d players)"),
+		*PlayerState->GetPlayerName(), CompressedSize, Raw.Num(), NewSnapshot.BrokenBits.CountSetBits(), NewSnapshot.BrokenBits.Num(), NewSnapshot.Players.Num());
+}
+
+void UGoombanicsJoinSnapshotSubsystem::ReceiveChunk(const TArray<uint8>& Chunk, int32 CompressedSize, int32 UncompressedSize)
+{
+	if (CompressedSize <= 0 || UncompressedSize <= 0 || UncompressedSize > MaxUncompressedSize
+		|| PendingBytes.Num() + Chunk.Num() > CompressedSize)
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("JoinSnapshot: malformed chunk (%d + %d of %d bytes), dropped"), PendingBytes.Num(), Chunk.Num(), CompressedSize);
+		PendingBytes.Reset();
+		return;
+	}
+
+	PendingBytes.Append(Chunk);
+	if (PendingBytes.Num() < CompressedSize)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GoombanicsJoinSnapshot);
+
+	TArray<uint8> Raw;
+	Raw.SetNumUninitialized(UncompressedSize);
+	const bool bDecompressed = FCompression::UncompressMemory(GoombanicsJoinSnapshot::CompressionFormat, Raw.GetData(), UncompressedSize, PendingBytes.GetData(), PendingBytes.Num());
+	PendingBytes.Reset();
+
+	FGoombanicsJoinSnapshot Received;
+	FMemoryReader Reader(Raw);
+	if (!bDecompressed || !Received.Serialize(Reader))
+	{
+		UE_LOG(LogGoombanics, Warning, TEXT("JoinSnapshot: could not read snapshot (%d bytes)"), UncompressedSize);
+		return;
+	}
+
+	Snapshot = MoveTemp(Received);
+	bHasSnapshot = true;
+	ApplySnapshot();
+}
+
+void UGoombanicsJoinSnapshotSubsystem::ApplySnapshot()
+{
+	// A round reset clears bits, so the snapshot may be older than the manager's
+	// replicated bitset; the destruction subsystem drops it in that case and
+	// otherwise lets the manager's first update correct it.
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		if (!Destruction->ApplyJoinSnapshotBits(Snapshot.BrokenBits))
+		{
+			UE_LOG(LogGoombanics, Log, TEXT("JoinSnapshot: destruction manager replicated first, snapshot bitset skipped"));
+		}
+	}
+
+	SnapshotAppliedTime = FPlatformTime::Seconds();
+	UE_LOG(LogGoombanics, Log, TEXT("JoinSnapshot: playable %.1f ms after world init (%d broken props, %d players)"),
+		(SnapshotAppliedTime - JoinStartTime) * 1000.0, Snapshot.BrokenBits.CountSetBits(), Snapshot.Players.Num());
+
+	OnJoinSnapshotReceived.Broadcast(Snapshot);
+}
+
+void UGoombanicsJoinSnapshotSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() != NM_Client)
+	{
+		bMeasuringJoin = false;
+		return;
+	}
+
+	// Benchmark baseline: the same state, pieced together from actor replication.
+	// A placed manager exists from map load; its bitset is sized once it replicates.
+	const UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(World);
+	const AGoombanicsDestructionManager* Manager = Destruction ? Destruction->GetManager() : nullptr;
+	if (!World->GetGameState<AGoombanicsGameState>() || !Manager || Manager->GetBrokenBits().Num() != Destruction->GetNumSlots())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	UE_LOG(LogGoombanics, Log, TEXT("JoinSnapshot: replicated state ready %.1f ms after world init (snapshot: %s)"),
+		(Now - JoinStartTime) * 1000.0,
+		bHasSnapshot ? *FString::Printf(TEXT("%.1f ms"), (SnapshotAppliedTime - JoinStartTime) * 1000.0) : TEXT("none"));
+
+	bMeasuringJoin = false;
+}
+
+TStatId UGoombanicsJoinSnapshotSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGoombanicsJoinSnapshotSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,173 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Goombanics/Core/GoombanicsTypes.h"
+#include "Goombanics/Destruction/GoombanicsDestructionManager.h"
+#include "GoombanicsJoinSnapshotSubsystem.generated.h"
+
+class AGoombanicsPlayerState;
+
+// One scoreboard row of the join snapshot.
+USTRUCT(BlueprintType)
+struct FGoombanicsJoinSnapshotPlayer
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	int32 PlayerId = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	EGoombanicsRole Role = EGoombanicsRole::Human;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	FGoombanicsPlayerScoreData ScoreData;
+};
+
+// -----------------------------------------------------------------------------
+// FGoombanicsJoinSnapshot
+//
+// Everything a late joiner needs to show the match, in one fixed layout:
+// version, match clock and phase, Kaiju state (controlling player, health,
+// stagger, location), weak points, destruction meter, destruction bitset (run
+// length packed, see FGoombanicsDestructionBitset) and the score table.
+// Serialize() is the wire format; bump Version when it changes.
+// -----------------------------------------------------------------------------
+USTRUCT(BlueprintType)
+struct GOOMBANICS_API FGoombanicsJoinSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	float ServerWorldTime = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	EGoombanicsMatchPhase MatchPhase = EGoombanicsMatchPhase::None;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	float TimeRemaining = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	bool bHasKaiju = false;
+
+	// PlayerId of the player possessing the Kaiju; INDEX_NONE while AI controls it.
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	int32 KaijuPlayerId = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	float KaijuHealthPercent = 1.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	bool bKaijuStaggered = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	bool bTotalledAchieved = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	FVector KaijuLocation = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	float KaijuYaw = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	TArray<FGoombanicsWeakPointState> WeakPoints;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	float DestructionPercent = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	float CurrentDestructionValue = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	float TotalDestructionValue = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Net")
+	TArray<FGoombanicsJoinSnapshotPlayer> Players;
+
+	FGoombanicsDestructionBitset BrokenBits;
+
+	// Returns false on a version mismatch or malformed data (loading).
+	bool Serialize(FArchive& Ar);
+
+	static constexpr uint8 Version = 1;
+
+	// Upper bounds accepted from the wire.
+	static constexpr int32 MaxWeakPoints = 16;
+	static constexpr int32 MaxPlayers = 64;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGoombanicsJoinSnapshotReceived, const FGoombanicsJoinSnapshot&, Snapshot);
+
+// -----------------------------------------------------------------------------
+// UGoombanicsJoinSnapshotSubsystem
+//
+// Join in progress without waiting on every actor channel. When a remote player
+// joins, the server builds one FGoombanicsJoinSnapshot, compresses it and sends
+// it to that connection only, as reliable chunks on its PlayerState. The client
+// applies the destruction bitset to the level's breakables at once (no need to
+// wait for the destruction manager or individually replicated props) and
+// exposes the rest through GetJoinSnapshot / OnJoinSnapshotReceived so the HUD
+// has the full picture before GameState, PlayerStates and the Kaiju arrive.
+// Replicated state stays authoritative; the snapshot is never applied over it.
+//
+// Benchmark: clients log time-to-playable (snapshot applied) next to the time
+// until GameState and the destruction manager had replicated. Compare with
+// goombanics.Net.JoinSnapshot 0 on the server.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API UGoombanicsJoinSnapshotSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGoombanicsJoinSnapshotSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return bMeasuringJoin; }
+	virtual TStatId GetStatId() const override;
+
+	// Server: build and send the snapshot to a newly joined remote player.
+	void SendTo(AGoombanicsPlayerState* PlayerState);
+
+	// Server: current match state in snapshot form.
+	void BuildSnapshot(FGoombanicsJoinSnapshot& OutSnapshot) const;
+
+	// Client: one chunk of the compressed snapshot arrived (in order; reliable).
+	void ReceiveChunk(const TArray<uint8>& Chunk, int32 CompressedSize, int32 UncompressedSize);
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Net")
+	bool HasJoinSnapshot() const { return bHasSnapshot; }
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Net")
+	const FGoombanicsJoinSnapshot& GetJoinSnapshot() const { return Snapshot; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Net")
+	FOnGoombanicsJoinSnapshotReceived OnJoinSnapshotReceived;
+
+	// Bytes per reliable chunk; keeps each RPC well under the partial bunch limit.
+	static constexpr int32 ChunkSize = 16 * 1024;
+
+	// Upper bound accepted from the wire (decompressed).
+	static constexpr int32 MaxUncompressedSize = 1024 * 1024;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void ApplySnapshot();
+
+	FGoombanicsJoinSnapshot Snapshot;
+	bool bHasSnapshot = false;
+
+	// Client: compressed bytes received so far.
+	TArray<uint8> PendingBytes;
+
+	// Client join timing (FPlatformTime seconds).
+	double JoinStartTime = 0.0;
+	double SnapshotAppliedTime = 0.0;
+	bool bMeasuringJoin = false;
+};
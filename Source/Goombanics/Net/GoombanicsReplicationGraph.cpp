@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsReplicationGraph.h"
+#include "Goombanics/Monster/GoombanicsKaijuPawn.h"
+#include "Goombanics/Player/GoombanicsCharacter.h"
+#include "Goombanics/Destruction/GoombanicsBreakableActor.h"
+#include "Engine/NetDriver.h"
+#include "UObject/UObjectIterator.h"
+
+void UGoombanicsReplicationGraph::InitGlobalActorClassSettings()
+{
+	// Base pass: default class info (cull distance, period) for every replicated class.
+	Super::InitGlobalActorClassSettings();
+
+	ClassRouting.Set(AGoombanicsKaijuPawn::StaticClass(), EGoombanicsRepNodeRouting::Kaiju);
+	ClassRouting.Set(AGoombanicsCharacter::StaticClass(), EGoombanicsRepNodeRouting::SpatializeDynamic);
+	ClassRouting.Set(AGoombanicsBreakableActor::StaticClass(), EGoombanicsRepNodeRouting::SpatializeDormancy);
+
+	// The Kaiju is never culled, and distance does not push it behind nearby actors:
+	// only starvation (time since last sent) orders it against the rest.
+	// The base pass already gave every loaded subclass (the spawned Blueprint Kaiju)
+	// its own default entry, so each one is overwritten, not just the native class.
+	// Subclasses loaded later inherit the native entry through the class map.
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if (!Class->IsChildOf(AGoombanicsKaijuPawn::StaticClass())
+			|| Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		FClassReplicationInfo KaijuInfo;
+		KaijuInfo.SetCullDistanceSquared(0.0f);
+		KaijuInfo.DistancePriorityScale = 0.0f;
+		KaijuInfo.StarvationPriorityScale = 2.0f;
+		KaijuInfo.ReplicationPeriodFrame = GetReplicationPeriodFrame(Class->GetDefaultObject<AActor>());
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, KaijuInfo);
+	}
+}
+
+void UGoombanicsReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	GridNode->CellSize = SpatialCellSize;
+
+	KaijuNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(KaijuNode);
+}
+
+EGoombanicsRepNodeRouting UGoombanicsReplicationGraph::GetRouting(const UClass* Class) const
+{
+	const EGoombanicsRepNodeRouting* Routing = ClassRouting.Get(Class);
+	return Routing ? *Routing : EGoombanicsRepNodeRouting::Default;
+}
+
+uint32 UGoombanicsReplicationGraph::GetReplicationPeriodFrame(const AActor* CDO) const
+{
+	const float ServerTickRate = NetDriver ? static_cast<float>(NetDriver->GetNetServerMaxTickRate()) : 30.0f;
+	const float UpdateFrequency = FMath::Max(1.0f, CDO->GetNetUpdateFrequency());
+	return static_cast<uint32>(FMath::Max(1, FMath::RoundToInt32(ServerTickRate / UpdateFrequency)));
+}
+
+void UGoombanicsReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetRouting(ActorInfo.Class))
+	{
+	case EGoombanicsRepNodeRouting::Kaiju:
+		ensureMsgf(GlobalInfo.Settings.GetCullDistanceSquared() == 0.0f && GlobalInfo.Settings.DistancePriorityScale == 0.0f,
+			TEXT("Kaiju class %s did not resolve to the Kaiju class info; it would be distance culled"), *GetNameSafe(ActorInfo.Class));
+		KaijuNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+
+	case EGoombanicsRepNodeRouting::SpatializeDynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+
+	case EGoombanicsRepNodeRouting::SpatializeDormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+
+	default:
+		Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+		break;
+	}
+}
+
+void UGoombanicsReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetRouting(ActorInfo.Class))
+	{
+	case EGoombanicsRepNodeRouting::Kaiju:
+		KaijuNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+
+	case EGoombanicsRepNodeRouting::SpatializeDynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+
+	case EGoombanicsRepNodeRouting::SpatializeDormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+
+	default:
+		Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+		break;
+	}
+}
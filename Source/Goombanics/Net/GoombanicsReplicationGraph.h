@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "GoombanicsReplicationGraph.generated.h"
+
+enum class EGoombanicsRepNodeRouting : uint8
+{
+	// Not one of ours: UBasicReplicationGraph decides (always relevant, owner only or grid).
+	Default,
+	// Replicated to every connection, no distance priority fall-off.
+	Kaiju,
+	// Spatial grid, moving every frame.
+	SpatializeDynamic,
+	// Spatial grid, mostly dormant until something happens to it.
+	SpatializeDormancy,
+};
+
+// -----------------------------------------------------------------------------
+// UGoombanicsReplicationGraph
+//
+// Replication driver for online matches (MaxPlayers=12), set as the IpNetDriver's
+// ReplicationDriverClassName in DefaultEngine.ini. Replaces the per-connection
+// relevancy walk over every actor with prebuilt node lists:
+// - Always relevant: GameState, PlayerStates, destruction manager (bAlwaysRelevant).
+// - Kaiju: its own always-relevant node; visible city-wide, so distance never
+//   lowers its priority and it is not culled.
+// - Spatial grid: characters (dynamic), individually replicated breakables
+//   (dormancy aware). A connection only gathers the cells around its viewers,
+//   so server cost follows what each client can actually see.
+// - Projectiles have no channel; they travel as weapon component events.
+// - Owner only (PlayerController and friends): per-connection node, from the base.
+//
+// Level-placed breakables do not replicate at all (destruction bitset), so the
+// grid only ever holds the few with their own channel.
+// -----------------------------------------------------------------------------
+UCLASS(transient, config = Engine)
+class GOOMBANICS_API UGoombanicsReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	// Grid cell edge in world units; a city block or two.
+	UPROPERTY(config)
+	float SpatialCellSize = 8000.0f;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> KaijuNode;
+
+protected:
+	EGoombanicsRepNodeRouting GetRouting(const UClass* Class) const;
+
+	// Server frames between replications for a class's NetUpdateFrequency.
+	uint32 GetReplicationPeriodFrame(const AActor* CDO) const;
+
+	TClassMap<EGoombanicsRepNodeRouting> ClassRouting;
+};
@@ -15,6 +15,7 @@
 AGoombanicsCharacter::AGoombanicsCharacter()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	GetCapsuleComponent()->InitCapsuleSize(42.0f, 96.0f);
 
@@ -51,18 +52,18 @@ void AGoombanicsCharacter::BeginPlay()
 	}
 
 	CurrentHealth = MaxHealth;
+
+	// Native work only needs the tick while dashing; Blueprint Event Tick always does.
+	TickGate.KeepTickingForBlueprint(this);
 }
 
 void AGoombanicsCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	UpdateDash(DeltaTime);
+	INC_DWORD_STAT(STAT_GoombanicsCharacterTicks);
 
-	if (DashCooldownRemaining > 0.0f)
-	{
-		DashCooldownRemaining -= DeltaTime;
-	}
+	UpdateDash();
 }
 
 void AGoombanicsCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -102,6 +103,11 @@ void AGoombanicsCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInpu
 
 float AGoombanicsCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
+	if (!IsAlive())
+	{
+		return 0.0f;
+	}
+
 	float ActualDamage = Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
 
 	CurrentHealth = FMath::Max(0.0f, CurrentHealth - ActualDamage);
@@ -131,6 +137,26 @@ void AGoombanicsCharacter::Die()
 	UE_LOG(LogGoombanics, Log, TEXT("Player died"));
 }
 
+void AGoombanicsCharacter::ResetForRespawn(const FTransform& SpawnTransform)
+{
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	CurrentHealth = MaxHealth;
+	CancelDash();
+
+	if (WeaponComponent)
+	{
+		WeaponComponent->ResetWeaponState();
+	}
+
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	Movement->StopMovementImmediately();
+	Movement->SetMovementMode(MOVE_Walking);
+
+	SetActorEnableCollision(true);
+	SetActorHiddenInGame(false);
+}
+
 void AGoombanicsCharacter::Move(const FInputActionValue& Value)
 {
 	if (bIsDashing)
@@ -200,7 +226,7 @@ void AGoombanicsCharacter::SwitchWeapon()
 
 void AGoombanicsCharacter::StartDash()
 {
-	if (bIsDashing || DashCooldownRemaining > 0.0f)
+	if (bIsDashing || bDashOnCooldown)
 	{
 		return;
 	}
@@ -218,30 +244,49 @@ void AGoombanicsCharacter::StartDash()
 	}
 
 	bIsDashing = true;
-	DashTimeRemaining = DashDuration;
-	DashCooldownRemaining = DashCooldown;
+	bDashOnCooldown = true;
+	TickGate.SetReason(this, TickReason_Dash, true);
+	DashTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, DashDuration, FSimpleDelegate::CreateUObject(this, &AGoombanicsCharacter::EndDash));
+	DashCooldownTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, DashCooldown, FSimpleDelegate::CreateUObject(this, &AGoombanicsCharacter::OnDashCooldownElapsed));
 
 	GetCharacterMovement()->GroundFriction = 0.0f;
 }
 
-void AGoombanicsCharacter::UpdateDash(float DeltaTime)
+void AGoombanicsCharacter::UpdateDash()
 {
 	if (!bIsDashing)
 	{
 		return;
 	}
 
-	DashTimeRemaining -= DeltaTime;
-
-	if (DashTimeRemaining <= 0.0f)
-	{
-		bIsDashing = false;
-		GetCharacterMovement()->GroundFriction = 8.0f;
-		return;
-	}
-
 	float DashSpeed = DashDistance / DashDuration;
 	FVector DashVelocity = DashDirection * DashSpeed;
 	DashVelocity.Z = GetCharacterMovement()->Velocity.Z;
 	GetCharacterMovement()->Velocity = DashVelocity;
 }
+
+void AGoombanicsCharacter::EndDash()
+{
+	bIsDashing = false;
+	DashTimerHandle.Invalidate();
+	TickGate.SetReason(this, TickReason_Dash, false);
+	GetCharacterMovement()->GroundFriction = 8.0f;
+}
+
+void AGoombanicsCharacter::CancelDash()
+{
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, DashTimerHandle);
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, DashCooldownTimerHandle);
+
+	bDashOnCooldown = false;
+	if (bIsDashing)
+	{
+		EndDash();
+	}
+}
+
+void AGoombanicsCharacter::OnDashCooldownElapsed()
+{
+	bDashOnCooldown = false;
+	DashCooldownTimerHandle.Invalidate();
+}
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "Goombanics/Core/GoombanicsTimerWheelSubsystem.h"
+#include "Goombanics/Core/GoombanicsTickGate.h"
 #include "GoombanicsCharacter.generated.h"
 
 class UInputMappingContext;
@@ -27,6 +29,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Combat")
 	void Die();
 
+	// Respawn in place: the GameMode resets the dead pawn and moves it to a new start
+	// instead of destroying it and spawning a fresh character.
+	void ResetForRespawn(const FTransform& SpawnTransform);
+
 	UFUNCTION(BlueprintPure, Category = "Goombanics|Combat")
 	bool IsAlive() const { return CurrentHealth > 0.0f; }
 
@@ -50,7 +56,10 @@ protected:
 	void StartFire();
 	void StopFire();
 	void SwitchWeapon();
-	void UpdateDash(float DeltaTime);
+	void UpdateDash();
+	void EndDash();
+	void CancelDash();
+	void OnDashCooldownElapsed();
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Goombanics|Input")
 	TObjectPtr<UInputMappingContext> DefaultMappingContext;
@@ -91,8 +100,16 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Movement")
 	float DashCooldown = 1.0f;
 
+	// Character only ticks while dashing (or for a Blueprint Event Tick).
+	enum ETickReason : uint32
+	{
+		TickReason_Dash = 1 << 0,
+	};
+	FGoombanicsTickGate TickGate;
+
 	bool bIsDashing = false;
-	float DashTimeRemaining = 0.0f;
-	float DashCooldownRemaining = 0.0f;
+	bool bDashOnCooldown = false;
+	FGoombanicsTimerHandle DashTimerHandle;
+	FGoombanicsTimerHandle DashCooldownTimerHandle;
 	FVector DashDirection = FVector::ZeroVector;
 };
@@ -2,6 +2,7 @@
 
 #include "GoombanicsPlayerState.h"
 #include "Goombanics/Core/GoombanicsGameState.h"
+#include "Goombanics/Net/GoombanicsJoinSnapshotSubsystem.h"
 #include "Net/UnrealNetwork.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -15,6 +16,55 @@ void AGoombanicsPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty
 
 	DOREPLIFETIME(AGoombanicsPlayerState, Role);
 	DOREPLIFETIME(AGoombanicsPlayerState, ScoreData);
+	DOREPLIFETIME(AGoombanicsPlayerState, LifetimeScoreData);
+	DOREPLIFETIME(AGoombanicsPlayerState, RoundsPlayed);
+}
+
+void AGoombanicsPlayerState::CopyProperties(APlayerState* PlayerState)
+{
+	Super::CopyProperties(PlayerState);
+
+	// Seamless travel (and reconnect): this is the old PlayerState, PlayerState the new one.
+	CopyCarriedState(Cast<AGoombanicsPlayerState>(PlayerState));
+}
+
+void AGoombanicsPlayerState::OverrideWith(APlayerState* PlayerState)
+{
+	Super::OverrideWith(PlayerState);
+
+	if (const AGoombanicsPlayerState* Old = Cast<AGoombanicsPlayerState>(PlayerState))
+	{
+		Old->CopyCarriedState(this);
+	}
+}
+
+void AGoombanicsPlayerState::CopyCarriedState(AGoombanicsPlayerState* Target) const
+{
+	if (!Target)
+	{
+		return;
+	}
+
+	Target->Role = Role;
+	Target->LifetimeScoreData = LifetimeScoreData;
+	Target->RoundsPlayed = RoundsPlayed;
+	Target->bCarriedOver = true;
+}
+
+void AGoombanicsPlayerState::ClientReceiveImpacts_Implementation(const FGoombanicsImpactBatch& Batch)
+{
+	if (UGoombanicsImpactEventSubsystem* Impacts = UGoombanicsImpactEventSubsystem::Get(this))
+	{
+		Impacts->ReceiveBatch(Batch);
+	}
+}
+
+void AGoombanicsPlayerState::ClientReceiveJoinSnapshotChunk_Implementation(const TArray<uint8>& Chunk, int32 CompressedSize, int32 UncompressedSize)
+{
+	if (UGoombanicsJoinSnapshotSubsystem* Snapshots = UGoombanicsJoinSnapshotSubsystem::Get(this))
+	{
+		Snapshots->ReceiveChunk(Chunk, CompressedSize, UncompressedSize);
+	}
 }
 
 void AGoombanicsPlayerState::SetRole(EGoombanicsRole NewRole)
@@ -62,3 +112,14 @@ void AGoombanicsPlayerState::ResetScore()
 {
 	ScoreData = FGoombanicsPlayerScoreData();
 }
+
+void AGoombanicsPlayerState::AccumulateLifetimeStats()
+{
+	LifetimeScoreData.KaijuDamageDealt += ScoreData.KaijuDamageDealt;
+	LifetimeScoreData.CollateralDamageScore += ScoreData.CollateralDamageScore;
+	LifetimeScoreData.WeakPointsDestroyed += ScoreData.WeakPointsDestroyed;
+	LifetimeScoreData.Deaths += ScoreData.Deaths;
+	LifetimeScoreData.FinalBlowCount += ScoreData.FinalBlowCount;
+	LifetimeScoreData.TotalScore += ScoreData.TotalScore;
+	RoundsPlayed++;
+}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerState.h"
 #include "Goombanics/Core/GoombanicsTypes.h"
+#include "Goombanics/Weapons/GoombanicsImpactEventSubsystem.h"
 #include "GoombanicsPlayerState.generated.h"
 
 // -----------------------------------------------------------------------------
@@ -18,6 +19,10 @@
 // - Role replicated so UI and gameplay can branch without hardcoded player indices.
 // - Score data replicated for scalable scoreboard (supports >4 online players later).
 //
+// Seamless travel: Role and lifetime stats (all finished rounds, every map) carry
+// into the next map's PlayerState through CopyProperties/OverrideWith; the
+// per-round ScoreData starts fresh.
+//
 // TODO(OnlineScaling): Move score aggregation to server-only updates with explicit RPCs if needed.
 // TODO(PlayerControlledKaiju): When a player is assigned Role=Kaiju, GameMode will possess the Kaiju pawn.
 // -----------------------------------------------------------------------------
@@ -31,6 +36,11 @@ public:
 	AGoombanicsPlayerState();
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void CopyProperties(APlayerState* PlayerState) override;
+	virtual void OverrideWith(APlayerState* PlayerState) override;
+
+	// True if this PlayerState took over Role and stats from the previous map.
+	bool WasCarriedOver() const { return bCarriedOver; }
 
 	UFUNCTION(BlueprintPure, Category = "Goombanics|Role")
 	EGoombanicsRole GetRole() const { return Role; }
@@ -114,10 +124,39 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Score")
 	void ResetScore();
 
+	// Server: adds this round's final score to the lifetime totals. Once per round, after CalculateFinalScore.
+	void AccumulateLifetimeStats();
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Score")
+	const FGoombanicsPlayerScoreData& GetLifetimeScoreData() const { return LifetimeScoreData; }
+
+	UFUNCTION(BlueprintPure, Category = "Goombanics|Score")
+	int32 GetRoundsPlayed() const { return RoundsPlayed; }
+
+	// Owning client: one frame of nearby impacts (see UGoombanicsImpactEventSubsystem).
+	UFUNCTION(Client, Unreliable)
+	void ClientReceiveImpacts(const FGoombanicsImpactBatch& Batch);
+
+	// Owning client: one chunk of the join snapshot (see UGoombanicsJoinSnapshotSubsystem).
+	UFUNCTION(Client, Reliable)
+	void ClientReceiveJoinSnapshotChunk(const TArray<uint8>& Chunk, int32 CompressedSize, int32 UncompressedSize);
+
 protected:
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Goombanics|Role")
 	EGoombanicsRole Role = EGoombanicsRole::Human;
 
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Goombanics|Score")
 	FGoombanicsPlayerScoreData ScoreData;
+
+	// Sum of every finished round since the player joined, across map travel.
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Goombanics|Score")
+	FGoombanicsPlayerScoreData LifetimeScoreData;
+
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Goombanics|Score")
+	int32 RoundsPlayed = 0;
+
+	bool bCarriedOver = false;
+
+private:
+	void CopyCarriedState(AGoombanicsPlayerState* Target) const;
 };
@@ -0,0 +1,243 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsImpactEventSubsystem.h"
+#include "Goombanics/Player/GoombanicsPlayerState.h"
+#include "Goombanics/Goombanics.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/HitResult.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/NetConnection.h"
+#include "Engine/ChildConnection.h"
+#include "GameFramework/PlayerController.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarImpactsCullDistance(
+	TEXT("goombanics.Impacts.CullDistance"),
+	8000.0f,
+	TEXT("Impacts further than this from a connection's view are not sent to it.\n")
+	TEXT("Impacts of the connection's own shots are always sent."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarImpactsMaxPerConnection(
+	TEXT("goombanics.Impacts.MaxPerConnection"),
+	64,
+	TEXT("Most impacts sent to one connection per frame; the rest of the frame is dropped."),
+	ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("Impact Event Batching"), STAT_GoombanicsImpactEvents, STATGROUP_Goombanics);
+
+namespace GoombanicsImpacts
+{
+	enum EFlags : uint8
+	{
+		Flag_HitDamageable = 1 << 0,
+		Flag_HitMarker = 1 << 1,
+	};
+}
+
+bool FGoombanicsImpactBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint32 NumImpacts = static_cast<uint32>(FMath::Min(Impacts.Num(), MaxImpacts));
+	Ar.SerializeIntPacked(NumImpacts);
+
+	if (Ar.IsLoading())
+	{
+		if (NumImpacts > static_cast<uint32>(MaxImpacts))
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+		Impacts.SetNum(static_cast<int32>(NumImpacts));
+	}
+
+	for (uint32 Index = 0; Index < NumImpacts && !Ar.IsError(); ++Index)
+	{
+		FGoombanicsImpact& Impact = Impacts[Index];
+
+		bOutSuccess &= SerializePackedVector<10, 24>(Impact.Location, Ar);
+		bOutSuccess &= SerializeFixedVector<1, 8>(Impact.Normal, Ar);
+
+		uint8 Surface = Impact.SurfaceType.GetValue();
+		uint8 Flags = (Impact.bHitDamageable ? GoombanicsImpacts::Flag_HitDamageable : 0)
+			| (Impact.bHitMarker ? GoombanicsImpacts::Flag_HitMarker : 0);
+		Ar << Surface;
+		Ar << Flags;
+
+		if (Ar.IsLoading())
+		{
+			Impact.SurfaceType = static_cast<EPhysicalSurface>(FMath::Min<uint8>(Surface, SurfaceType_Max - 1));
+			Impact.bHitDamageable = (Flags & GoombanicsImpacts::Flag_HitDamageable) != 0;
+			Impact.bHitMarker = (Flags & GoombanicsImpacts::Flag_HitMarker) != 0;
+		}
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return bOutSuccess;
+}
+
+UGoombanicsImpactEventSubsystem* UGoombanicsImpactEventSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGoombanicsImpactEventSubsystem>() : nullptr;
+}
+
+bool UGoombanicsImpactEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGoombanicsImpactEventSubsystem::Deinitialize()
+{
+	PendingImpacts.Reset();
+
+	Super::Deinitialize();
+}
+
+void UGoombanicsImpactEventSubsystem::AddImpact(const FHitResult& Hit, bool bHitDamageable, APlayerState* Instigator)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	FPendingImpact& Pending = PendingImpacts.AddDefaulted_GetRef();
+	Pending.Impact.Location = Hit.ImpactPoint;
+	Pending.Impact.Normal = Hit.ImpactNormal;
+	Pending.Impact.SurfaceType = UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get());
+	Pending.Impact.bHitDamageable = bHitDamageable;
+	Pending.Instigator = Instigator;
+}
+
+void UGoombanicsImpactEventSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_GoombanicsImpactEvents);
+
+	// Tickable subsystems run after actor ticks, so this is the whole frame's shots.
+	const UWorld* World = GetWorld();
+	if (World && World->GetNetMode() != NM_Standalone)
+	{
+		SendToConnections();
+	}
+#if !UE_SERVER
+	if (World && World->GetNetMode() != NM_DedicatedServer)
+	{
+		DispatchLocally();
+	}
+#endif
+
+	PendingImpacts.Reset();
+}
+
+void UGoombanicsImpactEventSubsystem::SendToConnections()
+{
+	const float CullDistanceSq = FMath::Square(CVarImpactsCullDistance.GetValueOnGameThread());
+	const int32 MaxPerConnection = FMath::Clamp(CVarImpactsMaxPerConnection.GetValueOnGameThread(), 1, FGoombanicsImpactBatch::MaxImpacts);
+
+	// Every player on one remote machine, keyed by its primary connection.
+	struct FRemoteMachine
+	{
+		AGoombanicsPlayerState* Receiver = nullptr;
+		TArray<const APlayerState*, TInlineAllocator<4>> PlayerStates;
+		TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	};
+	TMap<UNetConnection*, FRemoteMachine, TInlineSetAllocator<16>> Machines;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		AGoombanicsPlayerState* PS = PC ? PC->GetPlayerState<AGoombanicsPlayerState>() : nullptr;
+		UNetConnection* Connection = PC ? PC->NetConnection.Get() : nullptr;
+		if (!PS || !Connection || PC->IsLocalController())
+		{
+			continue;
+		}
+
+		UChildConnection* Child = Connection->GetUChildConnection();
+		UNetConnection* Primary = Child ? Child->GetParentConnection() : Connection;
+		if (!Primary)
+		{
+			continue;
+		}
+
+		FRemoteMachine& Machine = Machines.FindOrAdd(Primary);
+		if (!Child || !Machine.Receiver)
+		{
+			Machine.Receiver = PS;
+		}
+		Machine.PlayerStates.Add(PS);
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		Machine.ViewLocations.Add(ViewLocation);
+	}
+
+	FGoombanicsImpactBatch Batch;
+	for (const TPair<UNetConnection*, FRemoteMachine>& Pair : Machines)
+	{
+		const FRemoteMachine& Machine = Pair.Value;
+
+		Batch.Impacts.Reset();
+		for (const FPendingImpact& Pending : PendingImpacts)
+		{
+			const bool bOwnShot = Machine.PlayerStates.Contains(Pending.Instigator.Get());
+			if (!bOwnShot && !Machine.ViewLocations.ContainsByPredicate([&Pending, CullDistanceSq](const FVector& ViewLocation)
+				{
+					return FVector::DistSquared(ViewLocation, Pending.Impact.Location) <= CullDistanceSq;
+				}))
+			{
+				continue;
+			}
+
+			FGoombanicsImpact& Impact = Batch.Impacts.Add_GetRef(Pending.Impact);
+			Impact.bHitMarker = bOwnShot && Pending.Impact.bHitDamageable;
+
+			if (Batch.Impacts.Num() == MaxPerConnection)
+			{
+				break;
+			}
+		}
+
+		if (Batch.Impacts.Num() > 0)
+		{
+			Machine.Receiver->ClientReceiveImpacts(Batch);
+		}
+	}
+}
+
+void UGoombanicsImpactEventSubsystem::DispatchLocally()
+{
+	// Split-screen players share the world, so each impact plays once; the hit
+	// marker is set if any local player fired it.
+	for (const FPendingImpact& Pending : PendingImpacts)
+	{
+		FGoombanicsImpact Impact = Pending.Impact;
+
+		const APlayerState* Instigator = Pending.Instigator.Get();
+		const APlayerController* InstigatorPC = Instigator ? Instigator->GetPlayerController() : nullptr;
+		Impact.bHitMarker = Impact.bHitDamageable && InstigatorPC && InstigatorPC->IsLocalController();
+
+		OnImpact.Broadcast(Impact);
+	}
+}
+
+void UGoombanicsImpactEventSubsystem::ReceiveBatch(const FGoombanicsImpactBatch& Batch)
+{
+	for (const FGoombanicsImpact& Impact : Batch.Impacts)
+	{
+		OnImpact.Broadcast(Impact);
+	}
+}
+
+TStatId UGoombanicsImpactEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGoombanicsImpactEventSubsystem, STATGROUP_Tickables);
+}
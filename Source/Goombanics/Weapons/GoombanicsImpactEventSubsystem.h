@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "GoombanicsImpactEventSubsystem.generated.h"
+
+class APlayerState;
+struct FHitResult;
+
+// One impact as seen by a viewer.
+USTRUCT(BlueprintType)
+struct FGoombanicsImpact
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Impacts")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Impacts")
+	FVector Normal = FVector::UpVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Impacts")
+	TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+
+	// The shot hit something that takes damage (Kaiju, weak point, character).
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Impacts")
+	bool bHitDamageable = false;
+
+	// The viewer fired this shot and it hit something damageable: show a hit marker.
+	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Impacts")
+	bool bHitMarker = false;
+};
+
+// -----------------------------------------------------------------------------
+// FGoombanicsImpactBatch
+//
+// One frame of impacts for one connection. NetSerialize packs each impact as a
+// packed position to 0.1 units, a normal at 8 bits per axis, and the surface
+// type and flags at one byte each.
+// -----------------------------------------------------------------------------
+USTRUCT()
+struct GOOMBANICS_API FGoombanicsImpactBatch
+{
+	GENERATED_BODY()
+
+	TArray<FGoombanicsImpact> Impacts;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	// Upper bound accepted from the wire.
+	static constexpr int32 MaxImpacts = 255;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGoombanicsImpactBatch> : public TStructOpsTypeTraitsBase2<FGoombanicsImpactBatch>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGoombanicsImpact, const FGoombanicsImpact&, Impact);
+
+// -----------------------------------------------------------------------------
+// UGoombanicsImpactEventSubsystem
+//
+// Hit and impact feedback for every shot, without one RPC per bullet. The server
+// buffers the frame's impacts and, at the end of the frame, sends each remote
+// connection one unreliable client RPC (on its PlayerState) holding only the
+// impacts within goombanics.Impacts.CullDistance of its view, plus every impact
+// of its own shots (hit markers). Local viewers get the whole frame directly.
+//
+// A split-screen client has one child connection per extra local player; the
+// batch goes only to the primary connection's PlayerState and covers every view
+// on that machine, so each impact plays once there too.
+//
+// Listeners bind OnImpact to spawn decals, FX and hit markers; on clients it
+// fires when a batch arrives. Cosmetic only: a dropped batch loses effects, not
+// gameplay.
+// -----------------------------------------------------------------------------
+UCLASS()
+class GOOMBANICS_API UGoombanicsImpactEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGoombanicsImpactEventSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return PendingImpacts.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+
+	// Server: queue an impact from a hitscan or hit result. Ignored on clients.
+	void AddImpact(const FHitResult& Hit, bool bHitDamageable, APlayerState* Instigator);
+
+	// Client: a batch arrived for this connection.
+	void ReceiveBatch(const FGoombanicsImpactBatch& Batch);
+
+	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Impacts")
+	FOnGoombanicsImpact OnImpact;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	struct FPendingImpact
+	{
+		FGoombanicsImpact Impact;
+		TWeakObjectPtr<APlayerState> Instigator;
+	};
+
+	void SendToConnections();
+	void DispatchLocally();
+
+	TArray<FPendingImpact> PendingImpacts;
+};
@@ -1,11 +1,15 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GoombanicsProjectile.h"
+#include "GoombanicsWeaponComponent.h"
 #include "Goombanics/Monster/GoombanicsMonsterInterface.h"
 #include "Goombanics/Destruction/GoombanicsBreakableActor.h"
+#include "Goombanics/Destruction/GoombanicsBreakableField.h"
+#include "Goombanics/Destruction/GoombanicsDestructionSubsystem.h"
 #include "Goombanics/Goombanics.h"
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "GameFramework/Pawn.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/DamageEvents.h"
@@ -32,7 +36,8 @@ AGoombanicsProjectile::AGoombanicsProjectile()
 	ProjectileMovement->bShouldBounce = false;
 	ProjectileMovement->ProjectileGravityScale = 0.1f;
 
-	bReplicates = true;
+	// Flight is deterministic from the fire event; clients simulate their own copy.
+	bReplicates = false;
 }
 
 void AGoombanicsProjectile::BeginPlay()
@@ -57,17 +62,111 @@ void AGoombanicsProjectile::Initialize(float InDamage, float InSplashRadius, flo
 	}
 }
 
+void AGoombanicsProjectile::SetFiringWeapon(UGoombanicsWeaponComponent* InWeapon, uint16 InProjectileId)
+{
+	FiringWeapon = InWeapon;
+	ProjectileId = InProjectileId;
+}
+
+float AGoombanicsProjectile::GetGravityScale() const
+{
+	return ProjectileMovement ? ProjectileMovement->ProjectileGravityScale : 0.0f;
+}
+
+void AGoombanicsProjectile::InitializeCosmetic(const FGoombanicsProjectileFireEvent& Event, float FastForwardSeconds)
+{
+	bCosmetic = true;
+
+	const FVector LaunchVelocity = Event.Direction * Event.Speed;
+	const FVector Gravity(0.0f, 0.0f, GetWorld()->GetGravityZ() * Event.GravityScale);
+	const float Time = FMath::Max(0.0f, FastForwardSeconds);
+
+	// Same ballistic path the server's movement component integrates.
+	const FVector Location = Event.Origin + LaunchVelocity * Time + 0.5f * Gravity * Time * Time;
+	const FVector Velocity = LaunchVelocity + Gravity * Time;
+
+	if (ProjectileMovement)
+	{
+		ProjectileMovement->InitialSpeed = Event.Speed;
+		ProjectileMovement->MaxSpeed = Event.Speed;
+		ProjectileMovement->ProjectileGravityScale = Event.GravityScale;
+		ProjectileMovement->Velocity = Velocity;
+	}
+
+	// Whatever the skipped stretch of flight would have hit, it hit.
+	FHitResult Hit;
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(this);
+	QueryParams.AddIgnoredActor(GetOwner());
+	if (Time > 0.0f && GetWorld()->LineTraceSingleByChannel(Hit, Event.Origin, Location, ECC_Visibility, QueryParams))
+	{
+		ExplodeCosmetic(Hit.ImpactPoint);
+		return;
+	}
+
+	SetActorLocationAndRotation(Location, Velocity.Rotation());
+}
+
+void AGoombanicsProjectile::ExplodeCosmetic(const FVector& Location)
+{
+	if (bExploded)
+	{
+		return;
+	}
+
+	bExploded = true;
+
+	// The shooter sees their own splash break props now; the bitset confirms later.
+	const APawn* InstigatorPawn = GetInstigator();
+	if (InstigatorPawn && InstigatorPawn->IsLocallyControlled())
+	{
+		if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+		{
+			Destruction->PredictBreakInRadius(Location, SplashRadius);
+		}
+	}
+
+	ReceiveExplodeEffects(Location);
+	Destroy();
+}
+
 void AGoombanicsProjectile::OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
 	if (OtherActor && OtherActor != GetOwner())
 	{
-		Explode(Hit.ImpactPoint);
+		if (bCosmetic)
+		{
+			ExplodeCosmetic(Hit.ImpactPoint);
+		}
+		else
+		{
+			Explode(Hit.ImpactPoint);
+		}
 	}
 }
 
 void AGoombanicsProjectile::Explode(const FVector& Location)
 {
+	if (bExploded)
+	{
+		return;
+	}
+
+	bExploded = true;
 	ApplySplashDamage(Location);
+
+	if (UGoombanicsWeaponComponent* Weapon = FiringWeapon.Get())
+	{
+		Weapon->NotifyProjectileExploded(ProjectileId, Location);
+	}
+
+#if !UE_SERVER
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		ReceiveExplodeEffects(Location);
+	}
+#endif
+
 	Destroy();
 }
 
@@ -88,6 +187,14 @@ void AGoombanicsProjectile::ApplySplashDamage(const FVector& Location)
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActors(IgnoredActors);
 
+	APlayerState* InstigatorPlayerState = InstigatorController ? InstigatorController->GetPlayerState<APlayerState>() : nullptr;
+
+	// Breakables are resolved from packed positions, not from the physics sweep.
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		Destruction->BreakInRadius(Location, SplashRadius, InstigatorPlayerState);
+	}
+
 	if (GetWorld()->SweepMultiByChannel(HitResults, Location, Location, FQuat::Identity, ECC_Visibility, Sphere, QueryParams))
 	{
 		TSet<AActor*> ProcessedActors;
@@ -107,9 +214,9 @@ void AGoombanicsProjectile::ApplySplashDamage(const FVector& Location)
 				{
 					IGoombanicsMonsterInterface::Execute_ApplyDamageToMonster(HitActor, ActualDamage, InstigatorController, this);
 				}
-				else if (AGoombanicsBreakableActor* Breakable = Cast<AGoombanicsBreakableActor>(HitActor))
+				else if (HitActor->IsA<AGoombanicsBreakableActor>() || HitActor->IsA<AGoombanicsBreakableField>())
 				{
-					Breakable->Break(InstigatorController ? InstigatorController->GetPlayerState<APlayerState>() : nullptr);
+					continue;
 				}
 				else
 				{
@@ -4,12 +4,53 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Engine/NetSerialization.h"
 #include "GoombanicsProjectile.generated.h"
 
 class USphereComponent;
 class UProjectileMovementComponent;
 class UStaticMeshComponent;
+class UGoombanicsWeaponComponent;
 
+// Everything a client needs to fly its own copy of a server projectile.
+USTRUCT()
+struct FGoombanicsProjectileFireEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize10 Origin = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction = FVector::ForwardVector;
+
+	UPROPERTY()
+	float Speed = 0.0f;
+
+	UPROPERTY()
+	float GravityScale = 0.0f;
+
+	// Server world time at launch; clients fast-forward by the difference to now.
+	UPROPERTY()
+	float ServerFireTime = 0.0f;
+
+	// Per weapon component, wraps; pairs the fire event with its explode event.
+	UPROPERTY()
+	uint16 ProjectileId = 0;
+
+	UPROPERTY()
+	uint8 WeaponIndex = 0;
+};
+
+// -----------------------------------------------------------------------------
+// AGoombanicsProjectile
+//
+// Not replicated. The server's projectile is authoritative (hits, splash,
+// breaks); its weapon component multicasts a fire event and an explode event,
+// and each client flies a cosmetic copy from the fire event, fast-forwarded by
+// the time the event spent in flight. A cosmetic copy explodes (effects only) at
+// its own first hit or at the server's explode location, whichever comes first.
+// -----------------------------------------------------------------------------
 UCLASS()
 class GOOMBANICS_API AGoombanicsProjectile : public AActor
 {
@@ -23,6 +64,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Projectile")
 	void Initialize(float InDamage, float InSplashRadius, float InSplashDamage, float InSpeed);
 
+	// Server: the weapon component that multicasts this projectile's explode event.
+	void SetFiringWeapon(UGoombanicsWeaponComponent* InWeapon, uint16 InProjectileId);
+
+	// Client: fly as a cosmetic copy of the server projectile described by Event,
+	// starting FastForwardSeconds into its flight.
+	void InitializeCosmetic(const FGoombanicsProjectileFireEvent& Event, float FastForwardSeconds);
+
+	// Client: the server projectile exploded at Location.
+	void ExplodeCosmetic(const FVector& Location);
+
+	float GetGravityScale() const;
+
+	bool IsCosmetic() const { return bCosmetic; }
+
 protected:
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
@@ -30,6 +85,11 @@ protected:
 	void Explode(const FVector& Location);
 	void ApplySplashDamage(const FVector& Location);
 
+	// Explosion effects (FX, audio, camera shake). Runs wherever the explosion is seen,
+	// never on a dedicated server.
+	UFUNCTION(BlueprintImplementableEvent, Category = "Goombanics|Projectile", meta = (DisplayName = "On Explode Effects"))
+	void ReceiveExplodeEffects(const FVector& Location);
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Goombanics|Components")
 	TObjectPtr<USphereComponent> CollisionComponent;
 
@@ -50,4 +110,9 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Projectile")
 	float LifeSpan = 10.0f;
+
+	TWeakObjectPtr<UGoombanicsWeaponComponent> FiringWeapon;
+	uint16 ProjectileId = 0;
+	bool bCosmetic = false;
+	bool bExploded = false;
 };
@@ -2,21 +2,36 @@
 
 #include "GoombanicsWeaponComponent.h"
 #include "GoombanicsProjectile.h"
+#include "GoombanicsImpactEventSubsystem.h"
 #include "Goombanics/Monster/GoombanicsMonsterBase.h"
 #include "Goombanics/Monster/GoombanicsMonsterInterface.h"
 #include "Goombanics/Destruction/GoombanicsBreakableActor.h"
+#include "Goombanics/Destruction/GoombanicsBreakableField.h"
+#include "Goombanics/Destruction/GoombanicsDestructionSubsystem.h"
 #include "Goombanics/Core/GoombanicsTypes.h"
 #include "Goombanics/Goombanics.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/DamageEvents.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/PlayerController.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+
+namespace GoombanicsWeaponNet
+{
+	// Beyond this a fire event is treated as stale and flown from closer to its origin.
+	static constexpr float MaxProjectileFastForward = 0.5f;
+}
 
 FGoombanicsWeaponStats UGoombanicsWeaponComponent::EmptyWeaponStats;
 
 UGoombanicsWeaponComponent::UGoombanicsWeaponComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	// No per-frame state: owner-only ammo/index plus RPCs.
+	SetIsReplicatedByDefault(true);
 
 	FGoombanicsWeaponStats AssaultRifle;
 	AssaultRifle.WeaponName = FName("Assault Rifle");
@@ -42,6 +57,26 @@ UGoombanicsWeaponComponent::UGoombanicsWeaponComponent()
 	Weapons.Add(RocketLauncher);
 }
 
+void UGoombanicsWeaponComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(UGoombanicsWeaponComponent, CurrentWeaponIndex, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UGoombanicsWeaponComponent, CurrentAmmo, COND_OwnerOnly);
+}
+
+bool UGoombanicsWeaponComponent::HasFireAuthority() const
+{
+	const AActor* Owner = GetOwner();
+	return Owner && Owner->HasAuthority();
+}
+
+bool UGoombanicsWeaponComponent::IsLocallyControlledOwner() const
+{
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	return OwnerPawn && OwnerPawn->IsLocallyControlled();
+}
+
 void UGoombanicsWeaponComponent::BeginPlay()
 {
 	Super::BeginPlay();
@@ -50,32 +85,17 @@ void UGoombanicsWeaponComponent::BeginPlay()
 	{
 		CurrentAmmo = Weapons[CurrentWeaponIndex].AmmoCapacity;
 	}
+
+	TickGate.KeepTickingForBlueprint(this);
 }
 
 void UGoombanicsWeaponComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (FireCooldown > 0.0f)
-	{
-		FireCooldown -= DeltaTime;
-	}
+	INC_DWORD_STAT(STAT_GoombanicsWeaponTicks);
 
-	if (bIsReloading)
-	{
-		ReloadTimeRemaining -= DeltaTime;
-		if (ReloadTimeRemaining <= 0.0f)
-		{
-			bIsReloading = false;
-			if (Weapons.IsValidIndex(CurrentWeaponIndex))
-			{
-				CurrentAmmo = Weapons[CurrentWeaponIndex].AmmoCapacity;
-			}
-			OnReloadFinished.Broadcast();
-		}
-	}
-
-	if (bWantsToFire && !bIsReloading && FireCooldown <= 0.0f)
+	if (bWantsToFire && !bIsReloading && !bFireOnCooldown)
 	{
 		Fire();
 	}
@@ -84,11 +104,46 @@ void UGoombanicsWeaponComponent::TickComponent(float DeltaTime, ELevelTick TickT
 void UGoombanicsWeaponComponent::StartFire()
 {
 	bWantsToFire = true;
+
+	if (!HasFireAuthority())
+	{
+		ServerSetWantsToFire(true);
+
+		// The owning client runs its own fire loop for break prediction.
+		if (IsLocallyControlledOwner())
+		{
+			TickGate.SetReason(this, TickReason_WantsToFire, true);
+		}
+		return;
+	}
+
+	TickGate.SetReason(this, TickReason_WantsToFire, true);
 }
 
 void UGoombanicsWeaponComponent::StopFire()
 {
 	bWantsToFire = false;
+
+	if (!HasFireAuthority())
+	{
+		ServerSetWantsToFire(false);
+		TickGate.SetReason(this, TickReason_WantsToFire, false);
+		return;
+	}
+
+	TickGate.SetReason(this, TickReason_WantsToFire, false);
+}
+
+void UGoombanicsWeaponComponent::ServerSetWantsToFire_Implementation(bool bInWantsToFire)
+{
+	if (bInWantsToFire)
+	{
+		StartFire();
+	}
+	else
+	{
+		StopFire();
+	}
 }
 
 void UGoombanicsWeaponComponent::SwitchToNextWeapon()
@@ -109,12 +164,43 @@ void UGoombanicsWeaponComponent::SwitchToWeapon(int32 WeaponIndex)
 		return;
 	}
 
+	if (!HasFireAuthority())
+	{
+		ServerSwitchToWeapon(WeaponIndex);
+		return;
+	}
+
 	CurrentWeaponIndex = WeaponIndex;
 	CurrentAmmo = Weapons[CurrentWeaponIndex].AmmoCapacity;
-	bIsReloading = false;
-	FireCooldown = 0.0f;
+	CancelWeaponTimers();
 
 	OnWeaponSwitched.Broadcast(CurrentWeaponIndex);
+	BroadcastAmmoChanged();
+}
+
+void UGoombanicsWeaponComponent::ServerSwitchToWeapon_Implementation(int32 WeaponIndex)
+{
+	SwitchToWeapon(WeaponIndex);
+}
+
+void UGoombanicsWeaponComponent::OnRep_CurrentWeaponIndex()
+{
+	OnWeaponSwitched.Broadcast(CurrentWeaponIndex);
+}
+
+void UGoombanicsWeaponComponent::OnRep_CurrentAmmo(int32 PreviousAmmo)
+{
+	// Reloads and switches raise ammo; only a drop is a shot.
+	if (CurrentAmmo < PreviousAmmo)
+	{
+		OnWeaponFired.Broadcast(CurrentWeaponIndex, CurrentAmmo);
+	}
+	BroadcastAmmoChanged();
+}
+
+void UGoombanicsWeaponComponent::BroadcastAmmoChanged()
+{
+	OnAmmoChanged.Broadcast(CurrentAmmo, GetCurrentWeaponStats().AmmoCapacity);
 }
 
 void UGoombanicsWeaponComponent::StartReload()
@@ -124,14 +210,72 @@ void UGoombanicsWeaponComponent::StartReload()
 		return;
 	}
 
+	if (!HasFireAuthority())
+	{
+		ServerStartReload();
+		return;
+	}
+
 	if (CurrentAmmo >= Weapons[CurrentWeaponIndex].AmmoCapacity)
 	{
 		return;
 	}
 
+	const float ReloadTime = Weapons[CurrentWeaponIndex].ReloadTime;
 	bIsReloading = true;
-	ReloadTimeRemaining = Weapons[CurrentWeaponIndex].ReloadTime;
-	OnReloadStarted.Broadcast(ReloadTimeRemaining);
+	ReloadTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, ReloadTime, FSimpleDelegate::CreateUObject(this, &UGoombanicsWeaponComponent::FinishReload));
+	OnReloadStarted.Broadcast(ReloadTime);
+}
+
+void UGoombanicsWeaponComponent::ServerStartReload_Implementation()
+{
+	StartReload();
+}
+
+void UGoombanicsWeaponComponent::FinishReload()
+{
+	bIsReloading = false;
+	ReloadTimerHandle.Invalidate();
+
+	if (Weapons.IsValidIndex(CurrentWeaponIndex))
+	{
+		CurrentAmmo = Weapons[CurrentWeaponIndex].AmmoCapacity;
+	}
+	OnReloadFinished.Broadcast();
+	BroadcastAmmoChanged();
+}
+
+void UGoombanicsWeaponComponent::OnFireCooldownElapsed()
+{
+	bFireOnCooldown = false;
+	FireCooldownTimerHandle.Invalidate();
+}
+
+void UGoombanicsWeaponComponent::CancelWeaponTimers()
+{
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, ReloadTimerHandle);
+	UGoombanicsTimerWheelSubsystem::CancelTimer(this, FireCooldownTimerHandle);
+
+	bIsReloading = false;
+	bFireOnCooldown = false;
+}
+
+void UGoombanicsWeaponComponent::ResetWeaponState()
+{
+	StopFire();
+	CancelWeaponTimers();
+
+	const int32 PreviousWeaponIndex = CurrentWeaponIndex;
+	CurrentWeaponIndex = 0;
+	CurrentAmmo = Weapons.IsValidIndex(CurrentWeaponIndex) ? Weapons[CurrentWeaponIndex].AmmoCapacity : 0;
+
+	if (PreviousWeaponIndex != CurrentWeaponIndex)
+	{
+		OnWeaponSwitched.Broadcast(CurrentWeaponIndex);
+	}
+
+	// The HUD would otherwise show last round's magazine until the next shot.
+	BroadcastAmmoChanged();
 }
 
 const FGoombanicsWeaponStats& UGoombanicsWeaponComponent::GetCurrentWeaponStats() const
@@ -150,6 +294,14 @@ void UGoombanicsWeaponComponent::Fire()
 		return;
 	}
 
+	if (!HasFireAuthority())
+	{
+#if !UE_SERVER
+		PredictFire();
+#endif
+		return;
+	}
+
 	if (CurrentAmmo <= 0)
 	{
 		StartReload();
@@ -168,9 +320,41 @@ void UGoombanicsWeaponComponent::Fire()
 	}
 
 	CurrentAmmo--;
-	FireCooldown = 1.0f / Stats.FireRate;
+
+	bFireOnCooldown = true;
+	FireCooldownTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, 1.0f / Stats.FireRate, FSimpleDelegate::CreateUObject(this, &UGoombanicsWeaponComponent::OnFireCooldownElapsed));
 
 	OnWeaponFired.Broadcast(CurrentWeaponIndex, CurrentAmmo);
+	BroadcastAmmoChanged();
+}
+
+void UGoombanicsWeaponComponent::PredictFire()
+{
+	const FGoombanicsWeaponStats& Stats = Weapons[CurrentWeaponIndex];
+
+	// Replicated ammo lags the server by a round trip; an empty magazine here means
+	// the server is (or is about to be) reloading, so the shot is not predicted.
+	if (CurrentAmmo > 0 && Stats.FireMode == EGoombanicsFireMode::Hitscan)
+	{
+		const FVector Start = GetMuzzleLocation();
+		const FVector End = Start + GetAimDirection() * Stats.Range;
+
+		FHitResult HitResult;
+		FCollisionQueryParams QueryParams;
+		QueryParams.AddIgnoredActor(GetOwner());
+
+		if (GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, QueryParams))
+		{
+			if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+			{
+				Destruction->PredictBreakForHit(HitResult);
+			}
+		}
+	}
+
+	// Projectiles predict on the cosmetic copy's explosion instead (see AGoombanicsProjectile).
+	bFireOnCooldown = true;
+	FireCooldownTimerHandle = UGoombanicsTimerWheelSubsystem::ScheduleTimer(this, 1.0f / Stats.FireRate, FSimpleDelegate::CreateUObject(this, &UGoombanicsWeaponComponent::OnFireCooldownElapsed));
 }
 
 void UGoombanicsWeaponComponent::FireHitscan()
@@ -184,10 +368,20 @@ void UGoombanicsWeaponComponent::FireHitscan()
 	FHitResult HitResult;
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(GetOwner());
+	QueryParams.bReturnPhysicalMaterial = true;
 
 	if (GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, QueryParams))
 	{
 		ProcessHit(HitResult, Stats.Damage);
+
+		// Feedback for every client goes out in the frame's impact batch, not per shot.
+		if (UGoombanicsImpactEventSubsystem* Impacts = UGoombanicsImpactEventSubsystem::Get(this))
+		{
+			const AActor* HitActor = HitResult.GetActor();
+			const bool bHitDamageable = HitActor && (HitActor->Implements<UGoombanicsMonsterInterface>() || HitActor->IsA<APawn>());
+			const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+			Impacts->AddImpact(HitResult, bHitDamageable, OwnerPawn ? OwnerPawn->GetPlayerState() : nullptr);
+		}
 	}
 }
 
@@ -211,12 +405,104 @@ void UGoombanicsWeaponComponent::FireProjectile()
 	AGoombanicsProjectile* Projectile = GetWorld()->SpawnActor<AGoombanicsProjectile>(
 		Stats.ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
 
-	if (Projectile)
+	if (!Projectile)
+	{
+		return;
+	}
+
+	Projectile->Initialize(Stats.Damage, Stats.SplashRadius, Stats.SplashDamage, Stats.ProjectileSpeed);
+
+	if (GetNetMode() != NM_Standalone)
 	{
-		Projectile->Initialize(Stats.Damage, Stats.SplashRadius, Stats.SplashDamage, Stats.ProjectileSpeed);
+		const uint16 ProjectileId = NextProjectileId++;
+		Projectile->SetFiringWeapon(this, ProjectileId);
+
+		const AGameStateBase* GS = GetWorld()->GetGameState();
+
+		FGoombanicsProjectileFireEvent Event;
+		Event.Origin = SpawnLocation;
+		Event.Direction = SpawnRotation.Vector();
+		Event.Speed = Stats.ProjectileSpeed;
+		Event.GravityScale = Projectile->GetGravityScale();
+		Event.ServerFireTime = GS ? static_cast<float>(GS->GetServerWorldTimeSeconds()) : GetWorld()->GetTimeSeconds();
+		Event.ProjectileId = ProjectileId;
+		Event.WeaponIndex = static_cast<uint8>(CurrentWeaponIndex);
+		MulticastProjectileFired(Event);
 	}
 }
 
+void UGoombanicsWeaponComponent::MulticastProjectileFired_Implementation(const FGoombanicsProjectileFireEvent& Event)
+{
+#if !UE_SERVER
+	// The server already has the real projectile.
+	if (HasFireAuthority() || !Weapons.IsValidIndex(Event.WeaponIndex))
+	{
+		return;
+	}
+
+	const TSubclassOf<AGoombanicsProjectile> ProjectileClass = Weapons[Event.WeaponIndex].ProjectileClass;
+	if (!ProjectileClass)
+	{
+		return;
+	}
+
+	const AGameStateBase* GS = GetWorld()->GetGameState();
+	const float Now = GS ? static_cast<float>(GS->GetServerWorldTimeSeconds()) : GetWorld()->GetTimeSeconds();
+	const float FastForward = FMath::Clamp(Now - Event.ServerFireTime, 0.0f, GoombanicsWeaponNet::MaxProjectileFastForward);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = GetOwner();
+	SpawnParams.Instigator = Cast<APawn>(GetOwner());
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AGoombanicsProjectile* Projectile = GetWorld()->SpawnActor<AGoombanicsProjectile>(
+		ProjectileClass, Event.Origin, FVector(Event.Direction).Rotation(), SpawnParams);
+	if (!Projectile)
+	{
+		return;
+	}
+
+	for (auto It = CosmeticProjectiles.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	CosmeticProjectiles.Add(Event.ProjectileId, Projectile);
+
+	// Splash radius lets the owning client predict the explosion's breaks.
+	const FGoombanicsWeaponStats& Stats = Weapons[Event.WeaponIndex];
+	Projectile->Initialize(Stats.Damage, Stats.SplashRadius, Stats.SplashDamage, Event.Speed);
+	Projectile->InitializeCosmetic(Event, FastForward);
+#endif
+}
+
+void UGoombanicsWeaponComponent::NotifyProjectileExploded(uint16 ProjectileId, const FVector& Location)
+{
+	if (GetNetMode() != NM_Standalone)
+	{
+		MulticastProjectileExploded(ProjectileId, Location);
+	}
+}
+
+void UGoombanicsWeaponComponent::MulticastProjectileExploded_Implementation(uint16 ProjectileId, FVector_NetQuantize10 Location)
+{
+#if !UE_SERVER
+	if (HasFireAuthority())
+	{
+		return;
+	}
+
+	// Missing or stale: the cosmetic copy already exploded on its own hit.
+	TWeakObjectPtr<AGoombanicsProjectile> Projectile;
+	if (CosmeticProjectiles.RemoveAndCopyValue(ProjectileId, Projectile) && Projectile.IsValid())
+	{
+		Projectile->ExplodeCosmetic(Location);
+	}
+#endif
+}
+
 void UGoombanicsWeaponComponent::ProcessHit(const FHitResult& HitResult, float Damage)
 {
 	AActor* HitActor = HitResult.GetActor();
@@ -265,6 +551,10 @@ void UGoombanicsWeaponComponent::ProcessHit(const FHitResult& HitResult, float D
 	{
 		Breakable->Break(InstigatorController ? InstigatorController->GetPlayerState<APlayerState>() : nullptr);
 	}
+	else if (AGoombanicsBreakableField* Field = Cast<AGoombanicsBreakableField>(HitActor))
+	{
+		Field->BreakInstanceForHit(HitResult, InstigatorController ? InstigatorController->GetPlayerState<APlayerState>() : nullptr);
+	}
 	else
 	{
 		FDamageEvent DamageEvent;
@@ -277,6 +567,14 @@ void UGoombanicsWeaponComponent::ApplySplashDamage(const FVector& Location, floa
 	TArray<FHitResult> HitResults;
 	FCollisionShape Sphere = FCollisionShape::MakeSphere(Radius);
 
+	// Breakables are resolved from packed positions, not from the physics sweep.
+	if (UGoombanicsDestructionSubsystem* Destruction = UGoombanicsDestructionSubsystem::Get(this))
+	{
+		APawn* OwnerPawn = Cast<APawn>(GetOwner());
+		AController* InstigatorController = OwnerPawn ? OwnerPawn->GetController() : nullptr;
+		Destruction->BreakInRadius(Location, Radius, InstigatorController ? InstigatorController->GetPlayerState<APlayerState>() : nullptr);
+	}
+
 	if (GetWorld()->SweepMultiByChannel(HitResults, Location, Location, FQuat::Identity, ECC_Visibility, Sphere))
 	{
 		TSet<AActor*> ProcessedActors;
@@ -288,6 +586,11 @@ void UGoombanicsWeaponComponent::ApplySplashDamage(const FVector& Location, floa
 			{
 				ProcessedActors.Add(HitActor);
 
+				if (HitActor->IsA<AGoombanicsBreakableActor>() || HitActor->IsA<AGoombanicsBreakableField>())
+				{
+					continue;
+				}
+
 				float Distance = FVector::Dist(Location, HitActor->GetActorLocation());
 				float DamageScale = 1.0f - (Distance / Radius);
 				float ActualDamage = Damage * FMath::Max(0.0f, DamageScale);
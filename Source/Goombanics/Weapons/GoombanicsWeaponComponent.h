@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Goombanics/Core/GoombanicsTimerWheelSubsystem.h"
+#include "Goombanics/Core/GoombanicsTickGate.h"
+#include "GoombanicsProjectile.h"
 #include "GoombanicsWeaponComponent.generated.h"
 
 class UGoombanicsWeaponData;
-class AGoombanicsProjectile;
 class UGoombanicsWeaponTuningDataAsset;
 
 UENUM(BlueprintType)
@@ -66,7 +68,19 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnWeaponFired, int32, WeaponIndex,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWeaponSwitched, int32, NewWeaponIndex);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnReloadStarted, float, ReloadTime);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnReloadFinished);
-
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAmmoChanged, int32, CurrentAmmo, int32, MaxAmmo);
+
+// -----------------------------------------------------------------------------
+// UGoombanicsWeaponComponent
+//
+// Firing runs where the pawn has authority. Remote clients forward trigger,
+// switch and reload input to the server; the owner gets ammo and weapon index
+// back through owner-only replication.
+//
+// Projectiles have no actor channel: the server multicasts a compact fire event
+// and an explode event through this component, and clients fly cosmetic copies
+// (see AGoombanicsProjectile).
+// -----------------------------------------------------------------------------
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class GOOMBANICS_API UGoombanicsWeaponComponent : public UActorComponent
 {
@@ -75,6 +89,7 @@ class GOOMBANICS_API UGoombanicsWeaponComponent : public UActorComponent
 public:
 	UGoombanicsWeaponComponent();
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void BeginPlay() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
@@ -93,6 +108,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Goombanics|Weapons")
 	void StartReload();
 
+	// Back to the first weapon with a full magazine and no pending fire/reload (pawn reuse).
+	void ResetWeaponState();
+
 	UFUNCTION(BlueprintPure, Category = "Goombanics|Weapons")
 	int32 GetCurrentWeaponIndex() const { return CurrentWeaponIndex; }
 
@@ -120,28 +138,85 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Weapons|Events")
 	FOnReloadFinished OnReloadFinished;
 
+	// Any change to CurrentAmmo: shots, reloads, switches and round resets.
+	UPROPERTY(BlueprintAssignable, Category = "Goombanics|Weapons|Events")
+	FOnAmmoChanged OnAmmoChanged;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Goombanics|Weapons")
 	TArray<FGoombanicsWeaponStats> Weapons;
 
+	// Server: a projectile fired by this component exploded; tell clients.
+	void NotifyProjectileExploded(uint16 ProjectileId, const FVector& Location);
+
 protected:
+	UFUNCTION(Server, Reliable)
+	void ServerSetWantsToFire(bool bInWantsToFire);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSwitchToWeapon(int32 WeaponIndex);
+
+	UFUNCTION(Server, Reliable)
+	void ServerStartReload();
+
+	// Rockets fire about once a second per player, so reliable costs little and
+	// guarantees the explode event never arrives before its fire event.
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastProjectileFired(const FGoombanicsProjectileFireEvent& Event);
+
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastProjectileExploded(uint16 ProjectileId, FVector_NetQuantize10 Location);
+
+	UFUNCTION()
+	void OnRep_CurrentWeaponIndex();
+
+	UFUNCTION()
+	void OnRep_CurrentAmmo(int32 PreviousAmmo);
+
+	bool HasFireAuthority() const;
+	bool IsLocallyControlledOwner() const;
+
 	virtual void Fire();
 	virtual void FireHitscan();
 	virtual void FireProjectile();
+
+	// Owning client: mirrors the server's fire loop to predict the breakables its
+	// hitscan shots hit. No ammo or damage; the server stays authoritative.
+	virtual void PredictFire();
 	virtual void ProcessHit(const FHitResult& HitResult, float Damage);
 	virtual void ApplySplashDamage(const FVector& Location, float Radius, float Damage);
 	virtual FVector GetMuzzleLocation() const;
 	virtual FVector GetAimDirection() const;
 
-	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Weapons")
+	void FinishReload();
+	void OnFireCooldownElapsed();
+	void CancelWeaponTimers();
+	void BroadcastAmmoChanged();
+
+	UPROPERTY(ReplicatedUsing = OnRep_CurrentWeaponIndex, BlueprintReadOnly, Category = "Goombanics|Weapons")
 	int32 CurrentWeaponIndex = 0;
 
-	UPROPERTY(BlueprintReadOnly, Category = "Goombanics|Weapons")
+	UPROPERTY(ReplicatedUsing = OnRep_CurrentAmmo, BlueprintReadOnly, Category = "Goombanics|Weapons")
 	int32 CurrentAmmo = 0;
 
+	// Cooldown and reload run on the timer wheel; the component only ticks to
+	// poll auto-fire while the trigger is held.
+	enum ETickReason : uint32
+	{
+		TickReason_WantsToFire = 1 << 0,
+	};
+	FGoombanicsTickGate TickGate;
+
 	bool bWantsToFire = false;
 	bool bIsReloading = false;
-	float FireCooldown = 0.0f;
-	float ReloadTimeRemaining = 0.0f;
+	bool bFireOnCooldown = false;
+	FGoombanicsTimerHandle FireCooldownTimerHandle;
+	FGoombanicsTimerHandle ReloadTimerHandle;
+
+	// Server: id for the next projectile's fire/explode event pair.
+	uint16 NextProjectileId = 0;
+
+	// Client: cosmetic projectiles in flight, by server projectile id.
+	TMap<uint16, TWeakObjectPtr<AGoombanicsProjectile>> CosmeticProjectiles;
 
 	static FGoombanicsWeaponStats EmptyWeaponStats;
 };
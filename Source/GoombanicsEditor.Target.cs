@@ -11,5 +11,6 @@ public class GoombanicsEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
 		ExtraModuleNames.Add("Goombanics");
+		ExtraModuleNames.Add("GoombanicsUI");
 	}
 }
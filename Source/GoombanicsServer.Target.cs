@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+// Headless dedicated server (Linux). Builds with UE_SERVER=1, which compiles out
+// client-only cosmetic paths in the game module. GoombanicsUI (HUD, widgets) is
+// ClientOnly and not part of this target.
+public class GoombanicsServerTarget : TargetRules
+{
+	public GoombanicsServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
+		ExtraModuleNames.Add("Goombanics");
+
+		// Server logs carry the boot time and memory lines used for profiling.
+		bUseLoggingInShipping = true;
+	}
+}
@@ -2,7 +2,7 @@
 
 #include "GoombanicsHUD.h"
 #include "GoombanicsHUDWidget.h"
-#include "Goombanics/Goombanics.h"
+#include "GoombanicsUI.h"
 #include "Blueprint/UserWidget.h"
 
 AGoombanicsHUD::AGoombanicsHUD()
@@ -19,7 +19,7 @@ void AGoombanicsHUD::BeginPlay()
 		if (HUDWidget)
 		{
 			HUDWidget->AddToPlayerScreen();
-			UE_LOG(LogGoombanics, Log, TEXT("HUD widget created"));
+			UE_LOG(LogGoombanicsUI, Log, TEXT("HUD widget created"));
 		}
 	}
 }
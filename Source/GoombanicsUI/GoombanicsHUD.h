@@ -10,7 +10,7 @@
 class UGoombanicsHUDWidget;
 
 UCLASS()
-class GOOMBANICS_API AGoombanicsHUD : public AHUD
+class GOOMBANICSUI_API AGoombanicsHUD : public AHUD
 {
 	GENERATED_BODY()
 
@@ -3,7 +3,7 @@
 #include "GoombanicsHUDWidget.h"
 #include "Goombanics/Core/GoombanicsGameState.h"
 #include "Goombanics/Player/GoombanicsPlayerState.h"
-#include "Goombanics/Goombanics.h"
+#include "GoombanicsUI.h"
 #include "Components/TextBlock.h"
 #include "Components/ProgressBar.h"
 #include "Components/VerticalBox.h"
@@ -157,6 +157,9 @@ void UGoombanicsHUDWidget::ShowEndOfRoundScreen(EGoombanicsMatchEndReason EndRea
 		case EGoombanicsMatchEndReason::TimerExpired:
 			ReasonString = TEXT("TIME'S UP!");
 			break;
+		case EGoombanicsMatchEndReason::ProtectedDistrictDestroyed:
+			ReasonString = TEXT("DISTRICT LOST!");
+			break;
 		default:
 			ReasonString = TEXT("MATCH ENDED");
 			break;
@@ -199,7 +202,7 @@ void UGoombanicsHUDWidget::RefreshScoreboard()
 		return A.GetTotalScore() > B.GetTotalScore();
 	});
 
-	UE_LOG(LogGoombanics, Log, TEXT("Scoreboard refreshed with %d players"), PlayerStates.Num());
+	UE_LOG(LogGoombanicsUI, Log, TEXT("Scoreboard refreshed with %d players"), PlayerStates.Num());
 }
 
 void UGoombanicsHUDWidget::BindToGameState()
@@ -217,7 +220,7 @@ void UGoombanicsHUDWidget::BindToGameState()
 	GS->OnMatchEnded.AddDynamic(this, &UGoombanicsHUDWidget::OnMatchEnded);
 
 	bBoundToGameState = true;
-	UE_LOG(LogGoombanics, Log, TEXT("HUD bound to GameState"));
+	UE_LOG(LogGoombanicsUI, Log, TEXT("HUD bound to GameState"));
 }
 
 void UGoombanicsHUDWidget::UpdateFromGameState()
@@ -237,7 +240,17 @@ void UGoombanicsHUDWidget::UpdateFromGameState()
 
 void UGoombanicsHUDWidget::OnMatchPhaseChanged(EGoombanicsMatchPhase NewPhase)
 {
-	UE_LOG(LogGoombanics, Log, TEXT("HUD: Match phase changed to %d"), static_cast<int32>(NewPhase));
+	UE_LOG(LogGoombanicsUI, Log, TEXT("HUD: Match phase changed to %d"), static_cast<int32>(NewPhase));
+
+	// An in-place RestartRound goes PostRound -> Warmup without rebuilding the HUD.
+	if (NewPhase == EGoombanicsMatchPhase::Warmup || NewPhase == EGoombanicsMatchPhase::InProgress)
+	{
+		if (EndOfRoundOverlay)
+		{
+			EndOfRoundOverlay->SetVisibility(ESlateVisibility::Collapsed);
+		}
+		ShowStaggerIndicator(false);
+	}
 }
 
 void UGoombanicsHUDWidget::OnDestructionPercentChanged(float NewPercent)
@@ -13,7 +13,7 @@ class UVerticalBox;
 class UOverlay;
 
 UCLASS()
-class GOOMBANICS_API UGoombanicsHUDWidget : public UUserWidget
+class GOOMBANICSUI_API UGoombanicsHUDWidget : public UUserWidget
 {
 	GENERATED_BODY()
 
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Client-only HUD and widgets (Type ClientOnly in Goombanics.uproject): never
+// built for the server target or loaded on dedicated servers. Reads the game
+// module only through GameState / PlayerState getters and their delegates;
+// the game module does not depend on this one.
+public class GoombanicsUI : ModuleRules
+{
+	public GoombanicsUI(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicIncludePaths.Add(ModuleDirectory);
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"UMG",
+			"Goombanics"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"Slate",
+			"SlateCore"
+		});
+	}
+}
@@ -0,0 +1,8 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GoombanicsUI.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, GoombanicsUI);
+
+DEFINE_LOG_CATEGORY(LogGoombanicsUI);